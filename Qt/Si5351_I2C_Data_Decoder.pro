@@ -1,24 +1,86 @@
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++11
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    main.cpp \
-    mainwindow.cpp
-
-HEADERS += \
-    mainwindow.h
-
-FORMS += \
-    mainwindow.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++14
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    bustime.cpp \
+    bustimewindow.cpp \
+    capture.cpp \
+    capturediff.cpp \
+    capturelistmodel.cpp \
+    catalogwindow.cpp \
+    cli.cpp \
+    diffwindow.cpp \
+    events.cpp \
+    freqplotwidget.cpp \
+    heatmap.cpp \
+    heatmapwidget.cpp \
+    i2cbus.cpp \
+    jointplan.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    plancache.cpp \
+    plancost.cpp \
+    pllplan.cpp \
+    redundant.cpp \
+    redundantwindow.cpp \
+    regdesc.cpp \
+    regindex.cpp \
+    registertablemodel.cpp \
+    selftest.cpp \
+    si5351.cpp \
+    statecatalog.cpp \
+    statehash.cpp \
+    stateworker.cpp \
+    sweep.cpp \
+    timeline.cpp \
+    writeseq.cpp \
+    writeseqwindow.cpp
+
+HEADERS += \
+    bustime.h \
+    bustimewindow.h \
+    capture.h \
+    capturediff.h \
+    capturelistmodel.h \
+    catalogwindow.h \
+    cli.h \
+    diffwindow.h \
+    events.h \
+    freqplotwidget.h \
+    heatmap.h \
+    heatmapwidget.h \
+    i2cbus.h \
+    jointplan.h \
+    mainwindow.h \
+    plancache.h \
+    plancost.h \
+    pllplan.h \
+    redundant.h \
+    redundantwindow.h \
+    regdesc.h \
+    regindex.h \
+    registertablemodel.h \
+    selftest.h \
+    si5351.h \
+    statecatalog.h \
+    statehash.h \
+    stateworker.h \
+    sweep.h \
+    timeline.h \
+    writeseq.h \
+    writeseqwindow.h
+
+FORMS += \
+    mainwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,137 @@
+// Si5351 I2C data decoder
+//
+// Per line I2C bus time and retune (frequency hop) latency estimates
+
+#include "si5351.h"
+#include "i2cbus.h"
+#include "bustime.h"
+
+// ****************************************************************
+
+void t_bus_timing::clear()
+{
+	lines.clear();
+	line_row.clear();
+	scl_Hz        = 0.0;
+	settle_secs   = 0.0;
+	total_secs    = 0.0;
+	hops          = 0;
+	hop_max_secs  = 0.0;
+	hop_mean_secs = 0.0;
+}
+
+void t_bus_timing::closeHop(const double hop_start, const double hop_time)
+{
+	t_bus_time_line &line = lines.back();
+
+	line.hop      = true;
+	line.hop_secs = line.cumulative_secs - hop_start;
+
+	// the same span .. from the start of the 1st line to the end of the last one's wire time and settle time
+	if (hop_time >= 0.0 && line.time >= 0.0)
+		line.measured_hop_secs = line.time + line.wire_secs + line.settle_secs - hop_time;
+
+	hops++;
+	hop_mean_secs += line.hop_secs;
+	if (hop_max_secs < line.hop_secs)
+		hop_max_secs = line.hop_secs;
+}
+
+void t_bus_timing::build(const t_capture &capture, const t_event_index *events, const double scl_Hz, const double settle_secs)
+{
+	clear();
+
+	this->scl_Hz      = scl_Hz;
+	this->settle_secs = settle_secs;
+
+	line_row.assign(capture.lines(), -1);
+
+	const double bus_free_secs = i2c_bus_free_secs(scl_Hz);
+
+	double       cumulative = 0.0;
+	double       hop_start  = -1.0;   // cumulative time at the start of the 1st write since the previous hop, -1 if none yet
+	double       hop_time   = -1.0;   // its time stamp
+	double       prev_time  = -1.0;   // time stamp of the previous written line
+	unsigned int event      = 0;
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size = capture.lineDataSize(i);
+		const uint8_t     *data = capture.lineData(i);
+
+		if (size == 0)
+			continue;
+
+		t_bus_time_line line;
+		line.line              = i;
+		line.bytes             = (uint16_t)size;
+		line.wire_secs         = i2c_write_secs(size, scl_Hz);
+		line.time              = capture.hasTimes() ? capture.line_time[i] : -1.0;
+		line.pll_reset         = false;
+		line.tune              = false;
+		line.hop               = false;
+		line.settle_secs       = 0.0;
+		line.hop_secs          = 0.0;
+		line.measured_gap_secs = -1.0;
+		line.measured_hop_secs = -1.0;
+
+		const int first = data[0];
+		const int last  = first + (int)size - 2;
+		if (first <= SI5351_REG_PLL_RESET && last >= SI5351_REG_PLL_RESET)
+			line.pll_reset = (data[1 + SI5351_REG_PLL_RESET - first] & 0xa0) ? true : false;
+
+		// a multisynth only retune has no PLL reset, so the frequency changes mark the retunes
+		if (events)
+		{
+			const std::vector <t_event> &ev = events->events;
+			while (event < ev.size() && ev[event].line < i)
+				event++;
+			for (unsigned int k = event; k < ev.size() && ev[k].line == i && !line.tune; k++)
+				line.tune = (ev[k].type == EVENT_PLL_FREQ || ev[k].type == EVENT_CLK_FREQ);
+		}
+		line.tune = line.tune || line.pll_reset;
+
+		// a retune is a run of tune lines, the 1st other line after it ends the hop
+		if (!line.tune && !lines.empty() && lines.back().tune)
+		{
+			closeHop(hop_start, hop_time);
+			hop_start = -1.0;
+		}
+
+		if (!lines.empty())
+			cumulative += bus_free_secs;
+
+		if (hop_start < 0.0)
+		{
+			hop_start = cumulative;
+			hop_time  = line.time;
+		}
+
+		cumulative += line.wire_secs;
+
+		if (line.time >= 0.0)
+		{
+			if (prev_time >= 0.0)
+				line.measured_gap_secs = line.time - prev_time;
+			prev_time = line.time;
+		}
+
+		if (line.pll_reset)
+		{	// the PLL settle time only follows a reset
+			line.settle_secs  = settle_secs;
+			cumulative       += settle_secs;
+		}
+
+		line.cumulative_secs = cumulative;
+
+		line_row[i] = (int)lines.size();
+		lines.push_back(line);
+	}
+
+	if (!lines.empty() && lines.back().tune)
+		closeHop(hop_start, hop_time);
+
+	total_secs = cumulative;
+	if (hops > 0)
+		hop_mean_secs /= hops;
+}
@@ -0,0 +1,56 @@
+// Si5351 I2C data decoder
+//
+// Per line I2C bus time and retune (frequency hop) latency estimates
+
+#ifndef BUSTIME_H
+#define BUSTIME_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+#include "events.h"
+
+#define BUS_TIME_DEFAULT_SCL_HZ         400000.0
+#define BUS_TIME_DEFAULT_SETTLE_SECS    1e-3        // modelled PLL lock time after a PLL reset
+
+struct t_bus_time_line
+{
+	uint32_t line;
+	uint16_t bytes;             // I2C bytes after the device address (register address + values)
+	bool     pll_reset;         // the line resets a PLL
+	bool     tune;              // the line changes a PLL/CLK frequency or resets a PLL
+	bool     hop;               // the last line of a retune (a run of tune lines) .. the hop times are only set on these
+	double   time;              // the line's time stamp, -1 if none
+	double   wire_secs;         // START, device address, bytes, ACKs, STOP
+	double   settle_secs;       // PLL settle time after the line (PLL resets only)
+	double   cumulative_secs;   // from the start of the capture to the end of this line (bus free time between lines included)
+	double   hop_secs;          // from the start of the 1st write since the previous hop to the end of this line (plus its settle time)
+	double   measured_gap_secs; // time stamp difference to the previous written line, -1 if there aren't time stamps
+	double   measured_hop_secs; // the same span from the time stamps (taken as the start of each line), -1 if unknown
+};
+
+struct t_bus_timing
+{
+	std::vector <t_bus_time_line> lines;   // every line that wrote something, in line order
+	std::vector <int>             line_row;  // capture line -> index into 'lines' (-1 if the line wrote nothing)
+
+	double scl_Hz;
+	double settle_secs;
+
+	double total_secs;
+	unsigned int hops;
+	double hop_max_secs;
+	double hop_mean_secs;
+
+	void clear();
+
+	// the retunes are found from the frequency change events of 'events' (nullptr = PLL resets only)
+	void build(const t_capture &capture, const t_event_index *events, const double scl_Hz, const double settle_secs);
+
+private:
+	// mark the last line as the end of a hop that started at 'hop_start' (cumulative) / 'hop_time' (time stamp)
+	void closeHop(const double hop_start, const double hop_time);
+};
+
+#endif
@@ -0,0 +1,216 @@
+// Si5351 I2C data decoder
+//
+// Bus time window .. per line and cumulative I2C wire time, and the latency of each retune
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+#include "bustimewindow.h"
+
+// ****************************************************************
+
+BusTimeModel::BusTimeModel(QObject *parent) :
+	QAbstractTableModel(parent),
+	m_timing(nullptr)
+{
+}
+
+int BusTimeModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid() || !m_timing)
+		return 0;
+	return (int)m_timing->lines.size();
+}
+
+int BusTimeModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : BUS_TIME_COLUMNS;
+}
+
+QVariant BusTimeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch (section)
+	{
+		case BUS_TIME_COL_LINE:         return QString("Line");
+		case BUS_TIME_COL_BYTES:        return QString("Bytes");
+		case BUS_TIME_COL_WIRE:         return QString("Wire");
+		case BUS_TIME_COL_SETTLE:       return QString("PLL settle");
+		case BUS_TIME_COL_CUMULATIVE:   return QString("Cumulative");
+		case BUS_TIME_COL_GAP:          return QString("Measured gap");
+		case BUS_TIME_COL_HOP:          return QString("Hop latency");
+		case BUS_TIME_COL_MEASURED_HOP: return QString("Measured hop");
+	}
+
+	return QVariant();
+}
+
+QVariant BusTimeModel::data(const QModelIndex &index, int role) const
+{
+	if (!m_timing || !index.isValid() || index.row() < 0 || index.row() >= (int)m_timing->lines.size())
+		return QVariant();
+
+	if (role == Qt::TextAlignmentRole)
+		return (int)(Qt::AlignRight | Qt::AlignVCenter);
+
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	const t_bus_time_line &line = m_timing->lines[index.row()];
+
+	QString s;
+
+	switch (index.column())
+	{
+		case BUS_TIME_COL_LINE:
+			return QString::number(1 + line.line);
+		case BUS_TIME_COL_BYTES:
+			return QString::number(line.bytes);
+		case BUS_TIME_COL_WIRE:
+			s.sprintf("%0.1f us", line.wire_secs * 1e6);
+			return s;
+		case BUS_TIME_COL_SETTLE:
+			if (!line.pll_reset)
+				return QString("");
+			s.sprintf("%0.1f us", line.settle_secs * 1e6);
+			return s;
+		case BUS_TIME_COL_CUMULATIVE:
+			s.sprintf("%0.3f ms", line.cumulative_secs * 1e3);
+			return s;
+		case BUS_TIME_COL_GAP:
+			if (line.measured_gap_secs < 0.0)
+				return QString("");
+			s.sprintf("%0.1f us", line.measured_gap_secs * 1e6);
+			return s;
+		case BUS_TIME_COL_HOP:
+			if (!line.hop)
+				return QString("");
+			s.sprintf("%0.1f us", line.hop_secs * 1e6);
+			return s;
+		case BUS_TIME_COL_MEASURED_HOP:
+			if (line.measured_hop_secs < 0.0)
+				return QString("");
+			s.sprintf("%0.1f us", line.measured_hop_secs * 1e6);
+			return s;
+	}
+
+	return QVariant();
+}
+
+void BusTimeModel::setTiming(const t_bus_timing *timing)
+{
+	beginResetModel();
+	m_timing = timing;
+	endResetModel();
+}
+
+// ****************************************************************
+
+BusTimeWindow::BusTimeWindow(QWidget *parent) :
+	QWidget(parent, Qt::Window),
+	m_capture(nullptr),
+	m_events(nullptr)
+{
+	setWindowTitle("Bus time");
+
+	m_timing.clear();
+
+	m_model = new BusTimeModel(this);
+
+	m_scl_combo = new QComboBox(this);
+	m_scl_combo->addItem("100 kHz", 100000.0);
+	m_scl_combo->addItem("400 kHz", 400000.0);
+	m_scl_combo->addItem("1 MHz", 1000000.0);
+	m_scl_combo->setCurrentIndex(1);
+
+	m_settle_spin = new QSpinBox(this);
+	m_settle_spin->setRange(0, 100000);
+	m_settle_spin->setValue((int)(BUS_TIME_DEFAULT_SETTLE_SECS * 1e6));
+
+	m_summary_label = new QLabel(this);
+
+	m_table_view = new QTableView(this);
+	m_table_view->setModel(m_model);
+	m_table_view->setSelectionBehavior(QAbstractItemView::SelectRows);
+	m_table_view->setSelectionMode(QAbstractItemView::SingleSelection);
+	m_table_view->verticalHeader()->setVisible(false);
+	connect(m_table_view, SIGNAL(clicked(QModelIndex)), this, SLOT(onClicked(QModelIndex)));
+
+	QHBoxLayout *top = new QHBoxLayout();
+	top->addWidget(new QLabel("SCL", this));
+	top->addWidget(m_scl_combo);
+	top->addWidget(new QLabel("PLL settle (us)", this));
+	top->addWidget(m_settle_spin);
+	top->addStretch(1);
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addLayout(top);
+	layout->addWidget(m_summary_label);
+	layout->addWidget(m_table_view, 1);
+
+	connect(m_scl_combo, SIGNAL(currentIndexChanged(int)), this, SLOT(onChanged()));
+	connect(m_settle_spin, SIGNAL(valueChanged(int)), this, SLOT(onChanged()));
+
+	resize(900, 500);
+}
+
+void BusTimeWindow::setCapture(const t_capture *capture, const t_event_index *events)
+{
+	m_capture = capture;
+	m_events  = events;
+
+	onChanged();
+}
+
+void BusTimeWindow::setCurrentLine(const int line)
+{
+	if (line < 0 || line >= (int)m_timing.line_row.size())
+		return;
+
+	// the nearest written line at or before it
+	int l = line;
+	while (l > 0 && m_timing.line_row[l] < 0)
+		l--;
+	const int row = m_timing.line_row[l];
+	if (row < 0)
+		return;
+
+	m_table_view->selectRow(row);
+	m_table_view->scrollTo(m_model->index(row, 0));
+}
+
+void BusTimeWindow::onChanged()
+{
+	m_model->setTiming(nullptr);
+
+	if (!m_capture)
+	{
+		m_timing.clear();
+		m_summary_label->setText("");
+		return;
+	}
+
+	m_timing.build(*m_capture, m_events, m_scl_combo->currentData().toDouble(), m_settle_spin->value() * 1e-6);
+
+	m_model->setTiming(&m_timing);
+
+	QString s;
+	s.sprintf("%u transactions, %0.3f ms on the bus .. %u retunes, hop latency mean %0.1f us, max %0.1f us",
+		(unsigned int)m_timing.lines.size(),
+		m_timing.total_secs * 1e3,
+		m_timing.hops,
+		m_timing.hop_mean_secs * 1e6,
+		m_timing.hop_max_secs * 1e6);
+	if (!m_capture->hasTimes())
+		s += " (no time stamps, nothing measured)";
+	m_summary_label->setText(s);
+}
+
+void BusTimeWindow::onClicked(const QModelIndex &index)
+{
+	if (index.row() >= 0 && index.row() < (int)m_timing.lines.size())
+		emit lineClicked((int)m_timing.lines[index.row()].line);
+}
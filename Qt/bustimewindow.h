@@ -0,0 +1,79 @@
+// Si5351 I2C data decoder
+//
+// Bus time window .. per line and cumulative I2C wire time, and the latency of each retune
+
+#ifndef BUSTIMEWINDOW_H
+#define BUSTIMEWINDOW_H
+
+#include <QWidget>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QLabel>
+#include <QComboBox>
+#include <QSpinBox>
+
+#include "bustime.h"
+
+#define BUS_TIME_COL_LINE           0
+#define BUS_TIME_COL_BYTES          1
+#define BUS_TIME_COL_WIRE           2
+#define BUS_TIME_COL_SETTLE         3
+#define BUS_TIME_COL_CUMULATIVE     4
+#define BUS_TIME_COL_GAP            5
+#define BUS_TIME_COL_HOP            6
+#define BUS_TIME_COL_MEASURED_HOP   7
+#define BUS_TIME_COLUMNS            8
+
+class BusTimeModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	BusTimeModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+	// the timing must stay alive (and unchanged) until the next setTiming() call
+	void setTiming(const t_bus_timing *timing);
+
+private:
+	const t_bus_timing *m_timing;
+};
+
+class BusTimeWindow : public QWidget
+{
+	Q_OBJECT
+
+public:
+	BusTimeWindow(QWidget *parent = nullptr);
+
+	// the capture and its events must stay alive (and unchanged) until the next setCapture() call
+	void setCapture(const t_capture *capture, const t_event_index *events);
+
+	void setCurrentLine(const int line);
+
+signals:
+	void lineClicked(int line);
+
+private slots:
+	void onChanged();
+
+	void onClicked(const QModelIndex &index);
+
+private:
+	const t_capture     *m_capture;
+	const t_event_index *m_events;
+
+	t_bus_timing m_timing;
+
+	BusTimeModel *m_model;
+	QComboBox    *m_scl_combo;
+	QSpinBox     *m_settle_spin;    // us
+	QLabel       *m_summary_label;
+	QTableView   *m_table_view;
+};
+
+#endif
@@ -0,0 +1,246 @@
+// Si5351 I2C data decoder
+//
+// Compact in-memory form of a loaded I2C capture file
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "si5351.h"
+#include "capture.h"
+
+// ****************************************************************
+
+static inline bool capture_is_space(const uint8_t c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+// a "0xNN" hex byte value, anything else (or out of range) is rejected
+static bool capture_parse_hex(const uint8_t *p, const unsigned int len, int &value)
+{
+	if (len < 4 || p[0] != '0' || (p[1] != 'x' && p[1] != 'X'))
+		return false;
+
+	int v = 0;
+	for (unsigned int i = 2; i < len; i++)
+	{
+		const uint8_t c = p[i];
+		int d;
+		if (c >= '0' && c <= '9')
+			d = c - '0';
+		else
+		if (c >= 'a' && c <= 'f')
+			d = 10 + c - 'a';
+		else
+		if (c >= 'A' && c <= 'F')
+			d = 10 + c - 'A';
+		else
+			return false;
+		v = (v << 4) | d;
+		if (v > 255)
+			return false;
+	}
+
+	value = v;
+	return true;
+}
+
+static bool capture_parse_seconds(const uint8_t *p, const unsigned int len, double &seconds)
+{
+	char buf[32];
+	if (len >= sizeof(buf))
+		return false;
+	memcpy(buf, p, len);
+	buf[len] = 0;
+
+	char *end = NULL;
+	seconds = strtod(buf, &end);
+	return end == &buf[len];
+}
+
+// ****************************************************************
+
+void t_capture::clear()
+{
+	text.clear();
+	line_offset.clear();
+	line_length.clear();
+	line_data.clear();
+	data.clear();
+	line_time.clear();
+}
+
+bool capture_parse(t_capture &capture)
+{
+	capture.line_offset.clear();
+	capture.line_length.clear();
+	capture.line_data.clear();
+	capture.data.clear();
+	capture.line_time.clear();
+
+	const uint8_t     *text = capture.text.empty() ? NULL : &capture.text[0];
+	const unsigned int size = (unsigned int)capture.text.size();
+
+	// the tokens of the current line, NULL characters removed
+	std::vector <uint8_t>      token_text;
+	std::vector <unsigned int> token_start;
+
+	unsigned int pos = 0;
+	while (pos < size)
+	{
+		unsigned int start = pos;
+		while (pos < size && text[pos] != '\n')
+			pos++;
+		unsigned int end = pos;
+		if (pos < size)
+			pos++;	// skip the '\n'
+
+		// trim
+		while (start < end && (capture_is_space(text[start]) || text[start] == 0))
+			start++;
+		while (end > start && (capture_is_space(text[end - 1]) || text[end - 1] == 0))
+			end--;
+
+		if (start >= end)
+			continue;
+
+		if (text[start] == '#' || text[start] == ';')	// drop comment lines
+			continue;
+
+		// split the line up into tokens
+		token_text.clear();
+		token_start.clear();
+		bool in_token = false;
+		for (unsigned int i = start; i < end; i++)
+		{
+			const uint8_t c = text[i];
+			if (c == 0)
+				continue;
+			if (capture_is_space(c))
+			{
+				in_token = false;
+				continue;
+			}
+			if (!in_token)
+			{
+				token_start.push_back((unsigned int)token_text.size());
+				in_token = true;
+			}
+			token_text.push_back(c);
+		}
+		token_start.push_back((unsigned int)token_text.size());
+
+		const unsigned int tokens = (unsigned int)token_start.size() - 1;
+		if (tokens < 1)
+			continue;
+
+		const unsigned int line = (unsigned int)capture.line_offset.size();
+
+		capture.line_offset.push_back(start);
+		capture.line_length.push_back(end - start);
+		capture.line_data.push_back((uint32_t)capture.data.size());
+
+		if (!capture.line_time.empty())
+			capture.line_time.push_back(-1.0);
+
+		if (tokens < 2)
+			continue;
+
+		unsigned int first = 0;	// the register address token
+
+		const uint8_t     *t0     = &token_text[token_start[0]];
+		const unsigned int t0_len = token_start[1] - token_start[0];
+
+		if (t0_len > 1 && memchr(t0, '.', t0_len) != NULL)
+		{	// time stamped line .. "seconds addr data .."
+			double seconds;
+			if (!capture_parse_seconds(t0, t0_len, seconds) || seconds <= 0.0)
+				continue;
+
+			if (capture.line_time.empty())
+				capture.line_time.resize(line + 1, -1.0);
+			capture.line_time[line] = seconds;
+
+			first = 1;
+			if (tokens < 3)
+				continue;
+		}
+
+		int addr;
+		if (!capture_parse_hex(&token_text[token_start[first]], token_start[first + 1] - token_start[first], addr))
+			continue;
+
+		capture.data.push_back((uint8_t)addr);
+
+		for (unsigned int k = first + 1; k < tokens; k++)
+		{
+			int value;
+			if (capture_parse_hex(&token_text[token_start[k]], token_start[k + 1] - token_start[k], value))
+				capture.data.push_back((uint8_t)value);
+		}
+	}
+
+	capture.line_data.push_back((uint32_t)capture.data.size());
+
+	return !capture.line_offset.empty();
+}
+
+void capture_replay(const t_capture &capture, const int last_line, uint8_t *reg_values, bool *updated_regs)
+{
+	// start with the reset values - maybe
+	si5351_reset_regs(reg_values);
+
+	memset(updated_regs, 0, 256 * sizeof(bool));
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		memset(updated_regs, 0, 256 * sizeof(bool));
+
+		if (size > 0)
+		{
+			// clear the PLL self clearing bits
+			reg_values[SI5351_REG_PLL_RESET] &= 0x5f;
+
+			int addr = values[0];	// 1st byte is the register start address, following bytes is the register data values
+			for (unsigned int k = 1; k < size && addr < 256; k++)
+			{
+				updated_regs[addr] = true;
+				reg_values[addr++] = values[k];
+			}
+		}
+
+		if (last_line >= 0 && (int)i >= last_line)
+			break;	// stop on the selected line
+	}
+}
+
+void capture_line_text(const t_capture &capture, const unsigned int line, std::vector <char> &buf)
+{
+	buf.clear();
+
+	if (line >= capture.lines())
+		return;
+
+	const uint8_t *p   = &capture.text[capture.line_offset[line]];
+	const uint8_t *end = p + capture.line_length[line];
+
+	bool space = true;
+	for (; p < end; p++)
+	{
+		const uint8_t c = *p;
+		if (c == 0)
+			continue;
+		if (capture_is_space(c))
+		{
+			space = true;
+			continue;
+		}
+		if (space)
+			buf.push_back(' ');
+		buf.push_back((char)c);
+		space = false;
+	}
+}
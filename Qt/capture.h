@@ -0,0 +1,43 @@
+// Si5351 I2C data decoder
+//
+// Compact in-memory form of a loaded I2C capture file
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <vector>
+#include <stdint.h>
+
+// the file text is kept as is, each displayed line is just an offset/length into it,
+// and the I2C bytes of every line are packed one after the other into a single array
+struct t_capture
+{
+	std::vector <uint8_t>  text;          // the raw file contents
+	std::vector <uint32_t> line_offset;   // start of each displayed line in 'text'
+	std::vector <uint32_t> line_length;   //   "
+	std::vector <uint32_t> line_data;     // start of each line's I2C bytes in 'data' (one extra entry marks the end)
+	std::vector <uint8_t>  data;          // per line .. the register address followed by the register values written
+	std::vector <double>   line_time;     // time stamp (seconds) of each line, -1 if none .. empty if the capture has no time stamps
+
+	void clear();
+
+	unsigned int lines() const { return (unsigned int)line_offset.size(); }
+
+	bool hasTimes() const { return !line_time.empty(); }
+
+	// the I2C bytes of a line, the 1st byte is the register start address (0 bytes if the line wrote nothing)
+	unsigned int lineDataSize(const unsigned int line) const { return line_data[line + 1] - line_data[line]; }
+	const uint8_t *lineData(const unsigned int line) const { return data.data() + line_data[line]; }
+};
+
+// split the capture text up into lines and extract the I2C bytes from each of them
+bool capture_parse(t_capture &capture);
+
+// the register image after replaying the lines up to and including 'last_line' (all of them if -1) from the reset state,
+// 'updated_regs' flags the registers written by that last line
+void capture_replay(const t_capture &capture, const int last_line, uint8_t *reg_values, bool *updated_regs);
+
+// the displayed text of a line (white space collapsed to single spaces)
+void capture_line_text(const t_capture &capture, const unsigned int line, std::vector <char> &buf);
+
+#endif
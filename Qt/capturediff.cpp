@@ -0,0 +1,398 @@
+// Si5351 I2C data decoder
+//
+// Capture to capture diff .. aligns the I2C transactions of two captures
+
+#include <string.h>
+
+#include "si5351.h"
+#include "capturediff.h"
+
+// ****************************************************************
+
+struct t_diff_seq
+{
+	std::vector <uint64_t> hash;    // per transaction
+	std::vector <uint32_t> line;    // its capture line
+};
+
+struct t_diff_context
+{
+	const t_diff_seq *a;
+	const t_diff_seq *b;
+
+	std::vector <int> vf;           // forward furthest reaching x per diagonal
+	std::vector <int> vb;           // backward    "
+	int               offset;
+
+	std::vector <t_diff_op> *ops;
+
+	const std::atomic <bool> *cancel;
+	bool                      cancelled;
+};
+
+static void diff_make_seq(const t_capture &capture, t_diff_seq &seq)
+{
+	seq.hash.clear();
+	seq.line.clear();
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		if (size == 0)
+			continue;
+
+		// FNV-1a
+		uint64_t h = 0xcbf29ce484222325ull;
+		for (unsigned int k = 0; k < size; k++)
+		{
+			h ^= values[k];
+			h *= 0x100000001b3ull;
+		}
+		h ^= size;
+
+		seq.hash.push_back(h);
+		seq.line.push_back(i);
+	}
+}
+
+static void diff_emit(t_diff_context &ctx, const uint8_t type, const int ia, const int ib)
+{
+	t_diff_op op;
+	op.type   = type;
+	op.line_a = (type != DIFF_INSERT) ? ctx.a->line[ia] : 0;
+	op.line_b = (type != DIFF_DELETE) ? ctx.b->line[ib] : 0;
+	ctx.ops->push_back(op);
+}
+
+// the middle snake of A[a0, a1) vs B[b0, b1) .. returns the edit distance, the snake is (x, y) to (u, v)
+static int diff_middle_snake(t_diff_context &ctx, const int a0, const int a1, const int b0, const int b1, int &x_out, int &y_out, int &u_out, int &v_out)
+{
+	const uint64_t *A = &ctx.a->hash[0] + a0;
+	const uint64_t *B = &ctx.b->hash[0] + b0;
+
+	const int  N     = a1 - a0;
+	const int  M     = b1 - b0;
+	const int  delta = N - M;
+	const bool odd   = (delta & 1) ? true : false;
+	const int  max_d = (N + M + 1) / 2;
+
+	int *vf = &ctx.vf[0] + ctx.offset;
+	int *vb = &ctx.vb[0] + ctx.offset;
+
+	vf[1] = 0;
+	vb[1] = 0;
+
+	for (int d = 0; d <= max_d; d++)
+	{
+		if (ctx.cancel && (d & 255) == 255 && ctx.cancel->load())
+		{
+			ctx.cancelled = true;
+			return 0;
+		}
+
+		// forward
+		for (int k = -d; k <= d; k += 2)
+		{
+			int x = (k == -d || (k != d && vf[k - 1] < vf[k + 1])) ? vf[k + 1] : vf[k - 1] + 1;
+			int y = x - k;
+			const int xs = x;
+			const int ys = y;
+			while (x < N && y < M && A[x] == B[y])
+			{
+				x++;
+				y++;
+			}
+			vf[k] = x;
+
+			const int kb = delta - k;
+			if (odd && kb >= -(d - 1) && kb <= (d - 1) && vf[k] + vb[kb] >= N)
+			{
+				x_out = xs;
+				y_out = ys;
+				u_out = x;
+				v_out = y;
+				return (2 * d) - 1;
+			}
+		}
+
+		// backward .. x/y count back from the ends
+		for (int k = -d; k <= d; k += 2)
+		{
+			int x = (k == -d || (k != d && vb[k - 1] < vb[k + 1])) ? vb[k + 1] : vb[k - 1] + 1;
+			int y = x - k;
+			const int xs = x;
+			const int ys = y;
+			while (x < N && y < M && A[N - x - 1] == B[M - y - 1])
+			{
+				x++;
+				y++;
+			}
+			vb[k] = x;
+
+			const int kf = delta - k;
+			if (!odd && kf >= -d && kf <= d && vb[k] + vf[kf] >= N)
+			{
+				x_out = N - x;
+				y_out = M - y;
+				u_out = N - xs;
+				v_out = M - ys;
+				return 2 * d;
+			}
+		}
+	}
+
+	return -1;	// can't get here
+}
+
+static void diff_recurse(t_diff_context &ctx, int a0, int a1, int b0, int b1)
+{
+	if (ctx.cancelled)
+		return;
+
+	const uint64_t *A = &ctx.a->hash[0];
+	const uint64_t *B = &ctx.b->hash[0];
+
+	// common prefix
+	while (a0 < a1 && b0 < b1 && A[a0] == B[b0])
+		diff_emit(ctx, DIFF_EQUAL, a0++, b0++);
+
+	// common suffix .. emitted after the middle
+	int suffix = 0;
+	while (a0 < a1 && b0 < b1 && A[a1 - 1] == B[b1 - 1])
+	{
+		a1--;
+		b1--;
+		suffix++;
+	}
+
+	if (a0 == a1)
+	{
+		while (b0 < b1)
+			diff_emit(ctx, DIFF_INSERT, 0, b0++);
+	}
+	else
+	if (b0 == b1)
+	{
+		while (a0 < a1)
+			diff_emit(ctx, DIFF_DELETE, a0++, 0);
+	}
+	else
+	{
+		int x = 0, y = 0, u = 0, v = 0;
+		diff_middle_snake(ctx, a0, a1, b0, b1, x, y, u, v);
+		if (ctx.cancelled)
+			return;
+
+		diff_recurse(ctx, a0, a0 + x, b0, b0 + y);
+		for (int i = 0; i < u - x; i++)
+			diff_emit(ctx, DIFF_EQUAL, a0 + x + i, b0 + y + i);
+		diff_recurse(ctx, a0 + u, a1, b0 + v, b1);
+	}
+
+	for (int i = 0; i < suffix; i++)
+		diff_emit(ctx, DIFF_EQUAL, a1 + i, b1 + i);
+}
+
+// within each run of edits, pair up the deleted and inserted transactions that start at the same register
+static void diff_pair_changes(const t_capture &a, const t_capture &b, std::vector <t_diff_op> &ops)
+{
+	std::vector <t_diff_op> out;
+	out.reserve(ops.size());
+
+	std::vector <unsigned int> dels;
+	std::vector <unsigned int> inss;
+
+	unsigned int i = 0;
+	while (i < ops.size())
+	{
+		if (ops[i].type == DIFF_EQUAL)
+		{
+			out.push_back(ops[i++]);
+			continue;
+		}
+
+		unsigned int end = i;
+		while (end < ops.size() && ops[end].type != DIFF_EQUAL)
+			end++;
+
+		dels.clear();
+		inss.clear();
+		for (unsigned int k = i; k < end; k++)
+			(ops[k].type == DIFF_DELETE) ? dels.push_back(k) : inss.push_back(k);
+
+		// keeps both the A and the B lines in order
+		const unsigned int n = (unsigned int)((dels.size() > inss.size()) ? dels.size() : inss.size());
+		for (unsigned int p = 0; p < n; p++)
+		{
+			if (p < dels.size() && p < inss.size() && a.lineData(ops[dels[p]].line_a)[0] == b.lineData(ops[inss[p]].line_b)[0])
+			{
+				t_diff_op op = ops[dels[p]];
+				op.type   = DIFF_CHANGE;
+				op.line_b = ops[inss[p]].line_b;
+				out.push_back(op);
+				continue;
+			}
+			if (p < dels.size())
+				out.push_back(ops[dels[p]]);
+			if (p < inss.size())
+				out.push_back(ops[inss[p]]);
+		}
+
+		i = end;
+	}
+
+	ops.swap(out);
+}
+
+static void diff_apply_line(const t_capture &capture, const uint32_t line, uint8_t *regs, const uint8_t *other_regs, int &mismatches)
+{
+	const unsigned int size   = capture.lineDataSize(line);
+	const uint8_t     *values = capture.lineData(line);
+
+	// clear the PLL self clearing bits
+	{
+		const bool was = regs[SI5351_REG_PLL_RESET] != other_regs[SI5351_REG_PLL_RESET];
+		regs[SI5351_REG_PLL_RESET] &= 0x5f;
+		mismatches += (int)(regs[SI5351_REG_PLL_RESET] != other_regs[SI5351_REG_PLL_RESET]) - (int)was;
+	}
+
+	int addr = values[0];
+	for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+	{
+		const bool was = regs[addr] != other_regs[addr];
+		regs[addr] = values[k];
+		mismatches += (int)(regs[addr] != other_regs[addr]) - (int)was;
+	}
+}
+
+// the frequencies the chip is left at after 'line' (the reset state's before the first line)
+static const t_si5351_freqs &diff_line_freqs(const t_state_catalog &catalog, const int line, const t_si5351_freqs &reset_freqs)
+{
+	if (line < 0 || (unsigned int)line >= catalog.line_state.size())
+		return reset_freqs;
+	return catalog.states[catalog.line_state[line]].freqs;
+}
+
+static bool diff_freqs_differ(const t_si5351_freqs &fa, const t_si5351_freqs &fb)
+{
+	for (int pll = 0; pll < 2; pll++)
+		if (fa.pll_Hz[pll] != fb.pll_Hz[pll])
+			return true;
+	for (int clk = 0; clk < 8; clk++)
+		if (fa.clk_Hz[clk] != fb.clk_Hz[clk])
+			return true;
+	return false;
+}
+
+// ****************************************************************
+
+void t_capture_diff::clear()
+{
+	ops.clear();
+	edits.clear();
+	equal           = 0;
+	deleted         = 0;
+	inserted        = 0;
+	changed         = 0;
+	state_diverge_a = -1;
+	state_diverge_b = -1;
+	freq_diverge_a  = -1;
+	freq_diverge_b  = -1;
+}
+
+bool capture_diff(const t_capture &a, const t_state_catalog &catalog_a, const t_capture &b, const t_state_catalog &catalog_b, t_capture_diff &diff, const std::atomic <bool> *cancel)
+{
+	diff.clear();
+
+	t_diff_seq seq_a;
+	t_diff_seq seq_b;
+	diff_make_seq(a, seq_a);
+	diff_make_seq(b, seq_b);
+
+	const int N = (int)seq_a.hash.size();
+	const int M = (int)seq_b.hash.size();
+
+	t_diff_context ctx;
+	ctx.a         = &seq_a;
+	ctx.b         = &seq_b;
+	ctx.offset    = N + M + 2;
+	ctx.vf.assign((2 * ctx.offset) + 1, 0);
+	ctx.vb.assign((2 * ctx.offset) + 1, 0);
+	ctx.ops       = &diff.ops;
+	ctx.cancel    = cancel;
+	ctx.cancelled = false;
+
+	diff.ops.reserve((N > M) ? N : M);
+
+	diff_recurse(ctx, 0, N, 0, M);
+	if (ctx.cancelled)
+	{
+		diff.clear();
+		return false;
+	}
+
+	diff_pair_changes(a, b, diff.ops);
+
+	// ******************
+	// counts, and walk the alignment replaying both captures to find where they first diverge
+
+	uint8_t regs_a[256];
+	uint8_t regs_b[256];
+	si5351_reset_regs(regs_a);
+	si5351_reset_regs(regs_b);
+
+	// relative to a 1Hz reference as in the catalogs
+	t_si5351_freqs reset_freqs;
+	si5351_freqs_reset(&reset_freqs);
+	si5351_freqs_update(&reset_freqs, regs_a, 1.0, SI5351_DEP_ALL);
+
+	int mismatches = 0;
+	int line_a     = -1;
+	int line_b     = -1;
+
+	for (unsigned int i = 0; i < diff.ops.size(); i++)
+	{
+		const t_diff_op &op = diff.ops[i];
+
+		switch (op.type)
+		{
+			case DIFF_EQUAL:  diff.equal++;    break;
+			case DIFF_DELETE: diff.deleted++;  break;
+			case DIFF_INSERT: diff.inserted++; break;
+			case DIFF_CHANGE: diff.changed++;  break;
+		}
+
+		if (op.type != DIFF_EQUAL)
+			diff.edits.push_back(i);
+
+		if (op.type != DIFF_INSERT)
+		{
+			line_a = (int)op.line_a;
+			diff_apply_line(a, op.line_a, regs_a, regs_b, mismatches);
+		}
+		if (op.type != DIFF_DELETE)
+		{
+			line_b = (int)op.line_b;
+			diff_apply_line(b, op.line_b, regs_b, regs_a, mismatches);
+		}
+
+		if (mismatches > 0)
+		{
+			if (diff.state_diverge_a < 0 && diff.state_diverge_b < 0)
+			{
+				diff.state_diverge_a = line_a;
+				diff.state_diverge_b = line_b;
+			}
+
+			if (diff.freq_diverge_a < 0 && diff.freq_diverge_b < 0 && diff_freqs_differ(diff_line_freqs(catalog_a, line_a, reset_freqs), diff_line_freqs(catalog_b, line_b, reset_freqs)))
+			{
+				diff.freq_diverge_a = line_a;
+				diff.freq_diverge_b = line_b;
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,53 @@
+// Si5351 I2C data decoder
+//
+// Capture to capture diff .. aligns the I2C transactions of two captures
+
+#ifndef CAPTUREDIFF_H
+#define CAPTUREDIFF_H
+
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+#include "capture.h"
+#include "statecatalog.h"
+
+#define DIFF_EQUAL      0	// same transaction in both
+#define DIFF_DELETE     1	// only in capture A
+#define DIFF_INSERT     2	// only in capture B
+#define DIFF_CHANGE     3	// same start register, different data
+
+struct t_diff_op
+{
+	uint8_t  type;
+	uint32_t line_a;    // capture A line (not used for DIFF_INSERT)
+	uint32_t line_b;    // capture B line (not used for DIFF_DELETE)
+};
+
+struct t_capture_diff
+{
+	std::vector <t_diff_op> ops;      // the whole alignment, in order
+	std::vector <uint32_t>  edits;    // indexes into 'ops' of the non DIFF_EQUAL ones
+
+	unsigned int equal;
+	unsigned int deleted;
+	unsigned int inserted;
+	unsigned int changed;
+
+	// the first point of the alignment after which the register images (or the PLL/CLK frequencies)
+	// of the two captures differ .. the last line applied on each side, -1 if none (the reset state) or never
+	int state_diverge_a;
+	int state_diverge_b;
+	int freq_diverge_a;
+	int freq_diverge_b;
+
+	void clear();
+};
+
+// Myers O(ND) diff (linear space) over 64-bit hashes of the lines I2C bytes, lines without any are skipped,
+// the frequencies are compared from each capture's state catalog
+//
+// returns false if cancelled
+bool capture_diff(const t_capture &a, const t_state_catalog &catalog_a, const t_capture &b, const t_state_catalog &catalog_b, t_capture_diff &diff, const std::atomic <bool> *cancel = nullptr);
+
+#endif
@@ -0,0 +1,39 @@
+// Si5351 I2C data decoder
+//
+// List model over the capture lines, rows are rendered on demand from the capture text
+
+#include "capturelistmodel.h"
+
+CaptureListModel::CaptureListModel(QObject *parent) :
+	QAbstractListModel(parent),
+	m_capture(nullptr)
+{
+}
+
+int CaptureListModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid() || !m_capture)
+		return 0;
+	return (int)m_capture->lines();
+}
+
+QVariant CaptureListModel::data(const QModelIndex &index, int role) const
+{
+	if (role != Qt::DisplayRole || !m_capture || !index.isValid())
+		return QVariant();
+
+	const int row = index.row();
+	if (row < 0 || row >= (int)m_capture->lines())
+		return QVariant();
+
+	capture_line_text(*m_capture, row, m_buf);
+
+	return QString::fromLatin1(m_buf.empty() ? "" : &m_buf[0], (int)m_buf.size());
+}
+
+void CaptureListModel::setCapture(const t_capture *capture)
+{
+	beginResetModel();
+	m_capture = capture;
+	endResetModel();
+}
@@ -0,0 +1,33 @@
+// Si5351 I2C data decoder
+//
+// List model over the capture lines, rows are rendered on demand from the capture text
+
+#ifndef CAPTURELISTMODEL_H
+#define CAPTURELISTMODEL_H
+
+#include <QAbstractListModel>
+
+#include <vector>
+
+#include "capture.h"
+
+class CaptureListModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+public:
+	CaptureListModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+	// the capture must stay alive (and unchanged) until the next setCapture() call
+	void setCapture(const t_capture *capture);
+
+private:
+	const t_capture *m_capture;
+
+	mutable std::vector <char> m_buf;
+};
+
+#endif
@@ -0,0 +1,269 @@
+// Si5351 I2C data decoder
+//
+// State catalog window .. the distinct register configurations of the capture
+
+#include <QVBoxLayout>
+#include <QHeaderView>
+
+#include <algorithm>
+
+#include "catalogwindow.h"
+
+// ****************************************************************
+
+StateCatalogModel::StateCatalogModel(QObject *parent) :
+	QAbstractTableModel(parent),
+	m_catalog(nullptr),
+	m_xtal_Hz(SI5351_XTAL_HZ)
+{
+}
+
+int StateCatalogModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid() || !m_catalog)
+		return 0;
+	return (int)m_order.size();
+}
+
+int StateCatalogModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : CATALOG_COL_COLUMNS;
+}
+
+QVariant StateCatalogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch (section)
+	{
+		case CATALOG_COL_STATE: return QString("State");
+		case CATALOG_COL_COUNT: return QString("Lines");
+		case CATALOG_COL_FIRST: return QString("First");
+		case CATALOG_COL_LAST:  return QString("Last");
+		case CATALOG_COL_PLLA:  return QString("PLL-A");
+		case CATALOG_COL_PLLB:  return QString("PLL-B");
+		case CATALOG_COL_CLK0:  return QString("CLK-0");
+		case CATALOG_COL_CLK1:  return QString("CLK-1");
+		case CATALOG_COL_CLK2:  return QString("CLK-2");
+		case CATALOG_COL_CLK3:  return QString("CLK-3");
+		case CATALOG_COL_CLK4:  return QString("CLK-4");
+		case CATALOG_COL_CLK5:  return QString("CLK-5");
+		case CATALOG_COL_CLK6:  return QString("CLK-6");
+		case CATALOG_COL_CLK7:  return QString("CLK-7");
+	}
+
+	return QVariant();
+}
+
+QVariant StateCatalogModel::data(const QModelIndex &index, int role) const
+{
+	if (!m_catalog || !index.isValid() || index.row() < 0 || index.row() >= (int)m_order.size())
+		return QVariant();
+
+	if (role == Qt::TextAlignmentRole)
+		return (int)(Qt::AlignRight | Qt::AlignVCenter);
+
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	const uint32_t       s     = m_order[index.row()];
+	const t_state_entry &state = m_catalog->states[s];
+
+	double Hz;
+
+	switch (index.column())
+	{
+		case CATALOG_COL_STATE: return QString::number(1 + s);
+		case CATALOG_COL_COUNT: return QString::number(state.count);
+		case CATALOG_COL_FIRST: return QString::number(1 + state.first_line);
+		case CATALOG_COL_LAST:  return QString::number(1 + state.last_line);
+		case CATALOG_COL_PLLA:  Hz = state.freqs.pll_Hz[0]; break;
+		case CATALOG_COL_PLLB:  Hz = state.freqs.pll_Hz[1]; break;
+		case CATALOG_COL_CLK0:  Hz = state.freqs.clk_Hz[0]; break;
+		case CATALOG_COL_CLK1:  Hz = state.freqs.clk_Hz[1]; break;
+		case CATALOG_COL_CLK2:  Hz = state.freqs.clk_Hz[2]; break;
+		case CATALOG_COL_CLK3:  Hz = state.freqs.clk_Hz[3]; break;
+		case CATALOG_COL_CLK4:  Hz = state.freqs.clk_Hz[4]; break;
+		case CATALOG_COL_CLK5:  Hz = state.freqs.clk_Hz[5]; break;
+		case CATALOG_COL_CLK6:  Hz = state.freqs.clk_Hz[6]; break;
+		case CATALOG_COL_CLK7:  Hz = state.freqs.clk_Hz[7]; break;
+		default:                return QVariant();
+	}
+
+	Hz *= m_xtal_Hz;
+
+	QString s2;
+	if (Hz <= 0.0)
+		s2 = "--";
+	else
+	if (Hz >= 1e6)
+		s2.sprintf("%0.6f MHz", Hz / 1e6);
+	else
+		s2.sprintf("%0.3f kHz", Hz / 1e3);
+	return s2;
+}
+
+double StateCatalogModel::sortKey(const uint32_t state, const int column) const
+{
+	const t_state_entry &e = m_catalog->states[state];
+
+	switch (column)
+	{
+		case CATALOG_COL_COUNT: return e.count;
+		case CATALOG_COL_FIRST: return e.first_line;
+		case CATALOG_COL_LAST:  return e.last_line;
+		case CATALOG_COL_PLLA:  return e.freqs.pll_Hz[0];
+		case CATALOG_COL_PLLB:  return e.freqs.pll_Hz[1];
+		case CATALOG_COL_CLK0:  return e.freqs.clk_Hz[0];
+		case CATALOG_COL_CLK1:  return e.freqs.clk_Hz[1];
+		case CATALOG_COL_CLK2:  return e.freqs.clk_Hz[2];
+		case CATALOG_COL_CLK3:  return e.freqs.clk_Hz[3];
+		case CATALOG_COL_CLK4:  return e.freqs.clk_Hz[4];
+		case CATALOG_COL_CLK5:  return e.freqs.clk_Hz[5];
+		case CATALOG_COL_CLK6:  return e.freqs.clk_Hz[6];
+		case CATALOG_COL_CLK7:  return e.freqs.clk_Hz[7];
+	}
+
+	return state;
+}
+
+void StateCatalogModel::sort(int column, Qt::SortOrder order)
+{
+	if (!m_catalog)
+		return;
+
+	emit layoutAboutToBeChanged();
+
+	// stable on the state number
+	std::vector < std::pair <double, uint32_t> > keys(m_order.size());
+	for (unsigned int s = 0; s < keys.size(); s++)
+		keys[s] = std::make_pair(sortKey(s, column), (uint32_t)s);
+
+	if (order == Qt::AscendingOrder)
+		std::sort(keys.begin(), keys.end());
+	else
+		std::sort(keys.begin(), keys.end(), [](const std::pair <double, uint32_t> &a, const std::pair <double, uint32_t> &b)
+		{
+			return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+		});
+
+	for (unsigned int row = 0; row < keys.size(); row++)
+	{
+		m_order[row]               = keys[row].second;
+		m_row[keys[row].second]    = row;
+	}
+
+	emit layoutChanged();
+}
+
+void StateCatalogModel::setCatalog(const t_state_catalog *catalog)
+{
+	beginResetModel();
+
+	m_catalog = catalog;
+
+	const unsigned int states = catalog ? (unsigned int)catalog->states.size() : 0;
+	m_order.resize(states);
+	m_row.resize(states);
+	for (unsigned int s = 0; s < states; s++)
+	{
+		m_order[s] = s;
+		m_row[s]   = s;
+	}
+
+	endResetModel();
+}
+
+void StateCatalogModel::setXtalHz(const double xtal_Hz)
+{
+	m_xtal_Hz = xtal_Hz;
+
+	if (!m_order.empty())
+		emit dataChanged(index(0, CATALOG_COL_PLLA), index((int)m_order.size() - 1, CATALOG_COL_CLK7));
+}
+
+int StateCatalogModel::rowState(const int row) const
+{
+	return (row >= 0 && row < (int)m_order.size()) ? (int)m_order[row] : -1;
+}
+
+int StateCatalogModel::stateRow(const int state) const
+{
+	return (state >= 0 && state < (int)m_row.size()) ? (int)m_row[state] : -1;
+}
+
+// ****************************************************************
+
+StateCatalogWindow::StateCatalogWindow(QWidget *parent) :
+	QWidget(parent, Qt::Window),
+	m_catalog(nullptr)
+{
+	setWindowTitle("State catalog");
+
+	m_model = new StateCatalogModel(this);
+
+	m_summary_label = new QLabel(this);
+
+	m_table_view = new QTableView(this);
+	m_table_view->setModel(m_model);
+	m_table_view->setSelectionBehavior(QAbstractItemView::SelectRows);
+	m_table_view->setSelectionMode(QAbstractItemView::SingleSelection);
+	m_table_view->setSortingEnabled(true);
+	m_table_view->verticalHeader()->setVisible(false);
+	connect(m_table_view, SIGNAL(clicked(QModelIndex)), this, SLOT(onClicked(QModelIndex)));
+	connect(m_table_view, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(onDoubleClicked(QModelIndex)));
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addWidget(m_summary_label);
+	layout->addWidget(m_table_view, 1);
+
+	resize(1300, 500);
+}
+
+void StateCatalogWindow::setCatalog(const t_state_catalog *catalog)
+{
+	m_catalog = catalog;
+
+	m_model->setCatalog(catalog);
+
+	if (!catalog)
+	{
+		m_summary_label->setText("");
+		return;
+	}
+
+	m_summary_label->setText(QString::number(catalog->states.size()) + " distinct register states over " + QString::number(catalog->line_state.size()) + " lines .. click a state to go to its first line, double click for its last");
+}
+
+void StateCatalogWindow::setXtalHz(const double xtal_Hz)
+{
+	m_model->setXtalHz(xtal_Hz);
+}
+
+void StateCatalogWindow::setCurrentLine(const int line)
+{
+	if (!m_catalog || line < 0 || line >= (int)m_catalog->line_state.size())
+		return;
+
+	const int row = m_model->stateRow((int)m_catalog->line_state[line]);
+	if (row < 0)
+		return;
+
+	m_table_view->selectRow(row);
+	m_table_view->scrollTo(m_model->index(row, 0));
+}
+
+void StateCatalogWindow::onClicked(const QModelIndex &index)
+{
+	const int s = m_model->rowState(index.row());
+	if (m_catalog && s >= 0)
+		emit lineClicked((int)m_catalog->states[s].first_line);
+}
+
+void StateCatalogWindow::onDoubleClicked(const QModelIndex &index)
+{
+	const int s = m_model->rowState(index.row());
+	if (m_catalog && s >= 0)
+		emit lineClicked((int)m_catalog->states[s].last_line);
+}
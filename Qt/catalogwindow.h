@@ -0,0 +1,96 @@
+// Si5351 I2C data decoder
+//
+// State catalog window .. the distinct register configurations of the capture
+
+#ifndef CATALOGWINDOW_H
+#define CATALOGWINDOW_H
+
+#include <QWidget>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QLabel>
+
+#include <vector>
+
+#include "statecatalog.h"
+
+#define CATALOG_COL_STATE       0
+#define CATALOG_COL_COUNT       1
+#define CATALOG_COL_FIRST       2
+#define CATALOG_COL_LAST        3
+#define CATALOG_COL_PLLA        4
+#define CATALOG_COL_PLLB        5
+#define CATALOG_COL_CLK0        6
+#define CATALOG_COL_CLK1        7
+#define CATALOG_COL_CLK2        8
+#define CATALOG_COL_CLK3        9
+#define CATALOG_COL_CLK4        10
+#define CATALOG_COL_CLK5        11
+#define CATALOG_COL_CLK6        12
+#define CATALOG_COL_CLK7        13
+#define CATALOG_COL_COLUMNS     14
+
+class StateCatalogModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	StateCatalogModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+	// the catalog must stay alive (and unchanged) until the next setCatalog() call
+	void setCatalog(const t_state_catalog *catalog);
+
+	void setXtalHz(const double xtal_Hz);
+
+	// state of a row and row of a state
+	int rowState(const int row) const;
+	int stateRow(const int state) const;
+
+private:
+	const t_state_catalog *m_catalog;
+
+	double m_xtal_Hz;
+
+	std::vector <uint32_t> m_order;   // row -> state
+	std::vector <uint32_t> m_row;     // state -> row
+
+	double sortKey(const uint32_t state, const int column) const;
+};
+
+class StateCatalogWindow : public QWidget
+{
+	Q_OBJECT
+
+public:
+	StateCatalogWindow(QWidget *parent = nullptr);
+
+	void setCatalog(const t_state_catalog *catalog);
+
+	void setXtalHz(const double xtal_Hz);
+
+	// highlight the state the line leaves the chip in
+	void setCurrentLine(const int line);
+
+signals:
+	void lineClicked(int line);
+
+private slots:
+	void onClicked(const QModelIndex &index);
+
+	void onDoubleClicked(const QModelIndex &index);
+
+private:
+	const t_state_catalog *m_catalog;
+
+	StateCatalogModel *m_model;
+	QLabel            *m_summary_label;
+	QTableView        *m_table_view;
+};
+
+#endif
@@ -0,0 +1,533 @@
+// Si5351 I2C data decoder
+//
+// Command line (no GUI) commands
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QStringList>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+	#include <io.h>
+	#include <fcntl.h>
+#endif
+
+#include "si5351.h"
+#include "sweep.h"
+#include "jointplan.h"
+#include "selftest.h"
+#include "plancost.h"
+#include "plancache.h"
+#include "cli.h"
+
+// ****************************************************************
+
+bool cli_command(int argc, char *argv[])
+{
+	return argc >= 2 && (strcmp(argv[1], "sweep") == 0 || strcmp(argv[1], "plan") == 0 || strcmp(argv[1], "selftest") == 0);
+}
+
+#define CLI_WEIGHTS_HELP    "jitter cost model weights, pll_fractional,pll_odd,pll_vco_low,ms_fractional,ms_odd,ms_div_by_4,r_div,err_ppm"
+
+static bool cli_weights(const char *command, const QCommandLineParser &parser, const QCommandLineOption &option, t_plan_cost_weights &weights)
+{
+	weights = plan_cost_default_weights;
+	if (!parser.isSet(option))
+		return true;
+	if (plan_cost_parse_weights(parser.value(option).toLatin1().constData(), weights))
+		return true;
+	fprintf(stderr, "%s: bad --weights list\n", command);
+	return false;
+}
+
+static int cli_sweep(QCoreApplication &app)
+{
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Plan every step of a frequency sweep, output the PLL/MS register values, achieved frequency and error");
+	parser.addHelpOption();
+	parser.addPositionalArgument("sweep", "the sweep command");
+
+	QCommandLineOption start_option("start", "first frequency (Hz)", "Hz");
+	QCommandLineOption stop_option("stop", "last frequency (Hz)", "Hz");
+	QCommandLineOption step_option("step", "frequency step (Hz)", "Hz", "1000");
+	QCommandLineOption ref_option("ref", "reference (XTAL) frequency (Hz)", "Hz", QString::number(SI5351_XTAL_HZ));
+	QCommandLineOption clk_option("clk", "output 0 to 7", "n", "0");
+	QCommandLineOption pll_option("pll", "PLL 0 (A) or 1 (B)", "n", "0");
+	QCommandLineOption best_option("best", "best rational approximation of the fractions");
+	QCommandLineOption threads_option("threads", "worker threads (0 = one per core)", "n", "0");
+	QCommandLineOption channels_option("channels", "channel table file instead of --start/--stop/--step, one frequency (Hz) per line, # comments", "file");
+	QCommandLineOption cache_option("cache", "plan cache entries (0 = no cache)", "n", QString::number(PLAN_CACHE_DEFAULT_ENTRIES));
+	QCommandLineOption rank_option("rank", "rank each point's candidate plans by the jitter cost model");
+	QCommandLineOption weights_option("weights", CLI_WEIGHTS_HELP, "list");
+	QCommandLineOption fixed_option("fixed-pll", "keep one PLL VCO frequency for the whole sweep, only the multisynth changes");
+	QCommandLineOption budget_option("budget", "fixed PLL error budget (micro Hz)", "uHz", "1000000");
+	QCommandLineOption scl_option("scl", "I2C SCL rate for the delta format bus times (Hz)", "Hz", "400000");
+	QCommandLineOption format_option("format", "csv, bin or delta (fixed PLL only .. the register writes of each step)", "format", "csv");
+	QCommandLineOption out_option("out", "output file (default stdout)", "file");
+
+	parser.addOption(start_option);
+	parser.addOption(stop_option);
+	parser.addOption(step_option);
+	parser.addOption(ref_option);
+	parser.addOption(clk_option);
+	parser.addOption(pll_option);
+	parser.addOption(best_option);
+	parser.addOption(threads_option);
+	parser.addOption(channels_option);
+	parser.addOption(cache_option);
+	parser.addOption(rank_option);
+	parser.addOption(weights_option);
+	parser.addOption(fixed_option);
+	parser.addOption(budget_option);
+	parser.addOption(scl_option);
+	parser.addOption(format_option);
+	parser.addOption(out_option);
+
+	parser.process(app);
+
+	if (!parser.isSet(channels_option) && (!parser.isSet(start_option) || !parser.isSet(stop_option)))
+	{
+		fprintf(stderr, "sweep: --start and --stop (or --channels) are needed\n");
+		return 1;
+	}
+
+	std::vector <uint32_t> channels;
+	if (parser.isSet(channels_option))
+	{
+		const QByteArray name = parser.value(channels_option).toLocal8Bit();
+		FILE *file = fopen(name.constData(), "r");
+		if (!file)
+		{
+			fprintf(stderr, "sweep: unable to open %s\n", name.constData());
+			return 1;
+		}
+
+		char line[256];
+		unsigned int line_num = 0;
+		while (fgets(line, sizeof(line), file))
+		{
+			line_num++;
+
+			char *s = line;
+			while (*s == ' ' || *s == '\t')
+				s++;
+			if (*s == '#' || *s == '\r' || *s == '\n' || *s == '\0')
+				continue;
+
+			char *end = nullptr;
+			const unsigned long Hz = strtoul(s, &end, 10);
+			if (end == s || Hz == 0 || Hz > 0xffffffffu)
+			{
+				fprintf(stderr, "sweep: %s line %u isn't a frequency\n", name.constData(), line_num);
+				fclose(file);
+				return 1;
+			}
+			channels.push_back((uint32_t)Hz);
+		}
+		fclose(file);
+	}
+
+	const unsigned int cache_entries = parser.value(cache_option).toUInt();
+	t_plan_cache cache(cache_entries);
+
+	t_sweep_params params;
+	params.start_Hz  = parser.value(start_option).toUInt();
+	params.stop_Hz   = parser.value(stop_option).toUInt();
+	params.step_Hz   = parser.value(step_option).toUInt();
+	params.ref_Hz    = parser.value(ref_option).toUInt();
+	params.clk       = parser.value(clk_option).toUInt();
+	params.pll       = parser.value(pll_option).toUInt();
+	params.frac_mode = parser.isSet(best_option) ? PLL_FRAC_BEST : PLL_FRAC_DENOM;
+	params.threads   = parser.value(threads_option).toUInt();
+	params.channels  = parser.isSet(channels_option) ? &channels : nullptr;
+	params.fixed_pll = false;
+	params.cost      = nullptr;
+	params.cache     = (cache_entries > 0) ? &cache : nullptr;
+
+	t_plan_cost_weights weights;
+	if (!cli_weights("sweep", parser, weights_option, weights))
+		return 1;
+
+	t_plan_cost cost;
+	cost.fn      = plan_cost_jitter;
+	cost.context = &weights;
+	if (parser.isSet(rank_option))
+		params.cost = &cost;
+
+	const bool   binary     = (parser.value(format_option) == "bin");
+	const bool   delta      = (parser.value(format_option) == "delta");
+	const double budget_uHz = parser.value(budget_option).toDouble();
+	const double scl_Hz     = parser.value(scl_option).toDouble();
+
+	if (delta && !parser.isSet(fixed_option))
+	{
+		fprintf(stderr, "sweep: the delta format needs --fixed-pll\n");
+		return 1;
+	}
+
+	if (sweep_points(params) == 0 || params.clk >= PLL_PLAN_OUTPUTS || params.pll >= 2 || params.ref_Hz == 0)
+	{
+		fprintf(stderr, "sweep: bad parameters\n");
+		return 1;
+	}
+
+	if (parser.isSet(fixed_option))
+	{
+		unsigned int samples = 0;
+		const unsigned int reached = sweep_choose_fixed_pll(params, budget_uHz, params.fixed_pll_frac, &samples);
+		if (reached == 0)
+		{
+			fprintf(stderr, "sweep: no fixed PLL frequency reaches the range within the budget\n");
+			return 1;
+		}
+		params.fixed_pll = true;
+
+		const t_pll_frac &f = params.fixed_pll_frac;
+		fprintf(stderr, "sweep: fixed PLL %u + %u/%u (%0.3f Hz) reaches %u of %u sampled points\n",
+			f.a, f.b, f.c,
+			params.ref_Hz * (f.a + ((double)f.b / f.c)),
+			reached,
+			samples);
+	}
+
+	FILE *file = stdout;
+	if (parser.isSet(out_option))
+	{
+		file = fopen(parser.value(out_option).toLocal8Bit().constData(), binary ? "wb" : "w");
+		if (!file)
+		{
+			fprintf(stderr, "sweep: unable to create %s\n", parser.value(out_option).toLocal8Bit().constData());
+			return 1;
+		}
+	}
+	#ifdef _WIN32
+		else
+		if (binary)
+			_setmode(_fileno(stdout), _O_BINARY);
+	#endif
+
+	std::string          text;
+	std::vector <uint8_t> records;
+
+	if (!binary && !delta)
+	{
+		sweep_csv_header(text);
+		fwrite(text.data(), 1, text.size(), file);
+	}
+
+	// delta format state
+	t_sweep_point    prev;
+	bool             have_prev = false;
+	t_write_sequence writes;
+	std::string      burst_text;
+	uint64_t         delta_bytes = 0;
+	uint64_t         delta_steps = 0;
+
+	const bool ok = sweep_run(params, [&](const t_sweep_point *points, const unsigned int count)
+	{
+		if (delta)
+		{
+			text.clear();
+			for (unsigned int i = 0; i < count; i++)
+			{
+				const t_sweep_point &point = points[i];
+				char buf[96];
+
+				if (point.clk_Hz == 0 || fabs(point.err_uHz) > budget_uHz)
+				{
+					snprintf(buf, sizeof(buf), "# %u Hz out of budget (%0.3f uHz)\n", point.want_Hz, point.err_uHz);
+					text += buf;
+					continue;
+				}
+
+				snprintf(buf, sizeof(buf), "# %u Hz %0.3f uHz\n", point.want_Hz, point.err_uHz);
+				text += buf;
+
+				if (!have_prev)
+				{	// the full set up for the 1st point then the PLL reset
+					t_pll_plan plan;
+					pll_plan_init(plan, params.ref_Hz, params.frac_mode);
+					pll_plan_set_pll(plan, params.pll, params.fixed_pll_frac);
+					pll_plan_output_from_pll(plan, params.clk, params.pll, point.want_Hz);
+
+					uint8_t buffer[PLL_PLAN_BUFFER_SIZE];
+					const unsigned int size = pll_plan_buffer(plan, buffer);
+					for (unsigned int k = 0; k < size; k++)
+					{
+						snprintf(buf, sizeof(buf), (k == 0) ? "0x%02X" : " 0x%02X", buffer[k]);
+						text += buf;
+					}
+					snprintf(buf, sizeof(buf), "\n0x%02X 0x%02X\n", SI5351_REG_PLL_RESET, params.pll ? 0x80 : 0x20);
+					text += buf;
+				}
+				else
+				{
+					sweep_ms_delta(params, prev, point, scl_Hz, writes);
+					writes.text(burst_text);
+					text += burst_text;
+					for (unsigned int k = 0; k < writes.bursts.size(); k++)
+						delta_bytes += 1 + writes.bursts[k].values.size();
+					delta_steps++;
+				}
+
+				prev      = point;
+				have_prev = true;
+			}
+			return fwrite(text.data(), 1, text.size(), file) == text.size();
+		}
+
+		if (binary)
+		{
+			records.resize((size_t)count * SWEEP_RECORD_SIZE);
+			for (unsigned int i = 0; i < count; i++)
+				sweep_binary_record(points[i], &records[(size_t)i * SWEEP_RECORD_SIZE]);
+			return fwrite(&records[0], 1, records.size(), file) == records.size();
+		}
+
+		text.clear();
+		for (unsigned int i = 0; i < count; i++)
+			sweep_csv_line(points[i], text);
+		return fwrite(text.data(), 1, text.size(), file) == text.size();
+	});
+
+	if (file != stdout)
+		fclose(file);
+	else
+		fflush(stdout);
+
+	if (!ok)
+	{
+		fprintf(stderr, "sweep: write failed\n");
+		return 1;
+	}
+
+	if (delta && delta_steps > 0)
+		fprintf(stderr, "sweep: %0.2f bytes per step on average (register address + values)\n", (double)delta_bytes / delta_steps);
+
+	if (params.cache)
+	{
+		const uint64_t lookups = cache.hits() + cache.misses();
+		fprintf(stderr, "sweep: plan cache %llu hits, %llu misses (%0.1f%% hits), %llu evictions, %u entries\n",
+			(unsigned long long)cache.hits(),
+			(unsigned long long)cache.misses(),
+			(lookups > 0) ? (100.0 * cache.hits()) / lookups : 0.0,
+			(unsigned long long)cache.evictions(),
+			(unsigned int)cache.entries());
+	}
+
+	return 0;
+}
+
+static int cli_plan(QCoreApplication &app)
+{
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Plan several outputs at once, sharing them out between PLL-A and PLL-B, output the register values");
+	parser.addHelpOption();
+	parser.addPositionalArgument("plan", "the plan command");
+
+	QCommandLineOption ref_option("ref", "reference (XTAL) frequency (Hz)", "Hz", QString::number(SI5351_XTAL_HZ));
+	QCommandLineOption tol_option("tol", "default output tolerance (ppm)", "ppm", "1");
+	QCommandLineOption best_option("best", "best rational approximation of the fractions");
+	QCommandLineOption weights_option("weights", CLI_WEIGHTS_HELP, "list");
+
+	parser.addOption(ref_option);
+	parser.addOption(tol_option);
+	parser.addOption(best_option);
+	parser.addOption(weights_option);
+
+	std::vector <QCommandLineOption> clk_options;
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		clk_options.push_back(QCommandLineOption("clk" + QString::number(clk), "CLK-" + QString::number(clk) + " frequency, optionally with its own tolerance", "Hz[:ppm]"));
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		parser.addOption(clk_options[clk]);
+
+	parser.process(app);
+
+	const uint32_t ref_Hz    = parser.value(ref_option).toUInt();
+	const double   tol_ppm   = parser.value(tol_option).toDouble();
+	const int      frac_mode = parser.isSet(best_option) ? PLL_FRAC_BEST : PLL_FRAC_DENOM;
+
+	t_joint_output outputs[PLL_PLAN_OUTPUTS];
+	unsigned int   used = 0;
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		outputs[clk].freq_Hz = 0;
+		outputs[clk].tol_ppm = tol_ppm;
+
+		if (!parser.isSet(clk_options[clk]))
+			continue;
+
+		const QStringList parts = parser.value(clk_options[clk]).split(':');
+		bool ok = (parts.size() <= 2);
+		if (ok)
+			outputs[clk].freq_Hz = parts[0].toUInt(&ok);
+		if (ok && parts.size() == 2)
+			outputs[clk].tol_ppm = parts[1].toDouble(&ok);
+		if (!ok || outputs[clk].freq_Hz == 0 || outputs[clk].tol_ppm < 0.0)
+		{
+			fprintf(stderr, "plan: bad --clk%u value\n", clk);
+			return 1;
+		}
+		used++;
+	}
+
+	if (used == 0 || ref_Hz == 0)
+	{
+		fprintf(stderr, "plan: --ref and at least one --clkN are needed\n");
+		return 1;
+	}
+
+	t_plan_cost_weights weights;
+	if (!cli_weights("plan", parser, weights_option, weights))
+		return 1;
+
+	t_plan_cost cost;
+	cost.fn      = plan_cost_jitter;
+	cost.context = &weights;
+
+	t_pll_plan         plan;
+	t_joint_plan_stats stats;
+	const bool ok = joint_plan(ref_Hz, outputs, plan, frac_mode, &stats, &cost);
+
+	fprintf(stderr, "plan: %u candidate VCO frequencies, %u output/VCO plans, %u output groups usable, %u ruled out, cost %0.3f\n",
+		stats.candidates,
+		stats.evaluations,
+		stats.groups,
+		stats.pruned,
+		stats.cost);
+
+	if (!ok)
+	{
+		for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+			if (stats.unreachable & (1u << clk))
+				fprintf(stderr, "plan: CLK-%u %u Hz can't be reached within %0.3f ppm\n", clk, outputs[clk].freq_Hz, outputs[clk].tol_ppm);
+		if (stats.unreachable == 0)
+			fprintf(stderr, "plan: the outputs can't share two PLLs within their tolerances\n");
+		return 1;
+	}
+
+	for (unsigned int pll = 0; pll < 2; pll++)
+	{
+		if (!(plan.used_plls & (1u << pll)))
+			continue;
+		const t_pll_frac &f = plan.pll[pll];
+		printf("# PLL-%c %u + %u/%u  %u Hz%s\n", 'A' + pll, f.a, f.b, f.c, plan.pll_Hz[pll], ((f.a & 1) == 0 && f.b == 0) ? "  integer" : "");
+	}
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (!(plan.used_clks & (1u << clk)))
+			continue;
+		const t_pll_plan_ms &ms = plan.ms[clk];
+		printf("# CLK-%u %u Hz  PLL-%c  MS %u + %u/%u  R %u%s  error %0.6f Hz\n",
+			clk,
+			ms.want_Hz,
+			'A' + ms.pll,
+			ms.div.a, ms.div.b, ms.div.c,
+			1u << ms.r_div,
+			(ms.div_by_4 == 3) ? "  divide by 4" : "",
+			plan.clk_err_uHz[clk] * 1e-6);
+	}
+
+	uint8_t buffer[PLL_PLAN_BUFFER_SIZE];
+	const unsigned int size = pll_plan_buffer(plan, buffer);
+	for (unsigned int k = 0; k < size; k++)
+		printf((k == 0) ? "0x%02X" : " 0x%02X", buffer[k]);
+	printf("\n0x%02X 0x%02X\n", SI5351_REG_PLL_RESET, 0xA0);
+
+	return 0;
+}
+
+static int cli_selftest(QCoreApplication &app)
+{
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Plan random frequencies, decode the register images and check they agree, report the plan/decode rates");
+	parser.addHelpOption();
+	parser.addPositionalArgument("selftest", "the selftest command");
+
+	QCommandLineOption plans_option("plans", "random plans per reference/fraction mode", "n", "100000");
+	QCommandLineOption seed_option("seed", "random seed", "n", "1");
+	QCommandLineOption ref_option("ref", "reference (XTAL) frequency (Hz), default 25 and 27 MHz", "Hz");
+
+	parser.addOption(plans_option);
+	parser.addOption(seed_option);
+	parser.addOption(ref_option);
+
+	parser.process(app);
+
+	std::vector <uint32_t> refs;
+	if (parser.isSet(ref_option))
+		refs.push_back(parser.value(ref_option).toUInt());
+	else
+	{
+		refs.push_back(25000000);
+		refs.push_back(SI5351_XTAL_HZ);
+	}
+
+	t_selftest_params params;
+	params.plans = parser.value(plans_option).toUInt();
+	params.seed  = parser.value(seed_option).toUInt();
+
+	if (params.plans == 0)
+	{
+		fprintf(stderr, "selftest: bad --plans\n");
+		return 1;
+	}
+
+	bool all_ok = true;
+
+	for (unsigned int i = 0; i < refs.size(); i++)
+	{
+		for (int frac_mode = PLL_FRAC_DENOM; frac_mode <= PLL_FRAC_BEST; frac_mode++)
+		{
+			params.ref_Hz    = refs[i];
+			params.frac_mode = frac_mode;
+
+			t_selftest_result result;
+			const bool ok = selftest_round_trip(params, result);
+			all_ok = all_ok && ok;
+
+			printf("%s ref %u Hz %s: %u outputs, %u failed (%u plans outside the limits, %u outputs too far off), %u unplannable\n",
+				ok ? "PASS" : "FAIL",
+				params.ref_Hz,
+				(frac_mode == PLL_FRAC_BEST) ? "best" : "denom",
+				result.outputs,
+				result.failures,
+				result.out_of_limits,
+				result.off_target,
+				result.unplannable);
+			printf("     max difference .. exact %0.9f Hz, integer %0.3f Hz\n", result.max_err_diff_Hz, result.max_clk_diff_Hz);
+			printf("     %0.0f plans/s, %0.0f decodes/s\n",
+				(result.plan_secs   > 0.0) ? result.plans / result.plan_secs   : 0.0,
+				(result.decode_secs > 0.0) ? result.plans / result.decode_secs : 0.0);
+			if (!ok)
+				printf("%s", result.failure_text.c_str());
+		}
+	}
+
+	return all_ok ? 0 : 1;
+}
+
+int cli_main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	app.setApplicationVersion("1.0.6.0");
+
+	if (app.arguments().size() >= 2 && app.arguments().at(1) == "sweep")
+		return cli_sweep(app);
+
+	if (app.arguments().size() >= 2 && app.arguments().at(1) == "plan")
+		return cli_plan(app);
+
+	if (app.arguments().size() >= 2 && app.arguments().at(1) == "selftest")
+		return cli_selftest(app);
+
+	return 1;
+}
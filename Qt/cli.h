@@ -0,0 +1,20 @@
+// Si5351 I2C data decoder
+//
+// Command line (no GUI) commands
+//
+//   sweep     batch frequency sweep plan to CSV/binary
+//   plan      joint plan of several outputs
+//   selftest  planner <-> decoder round trip check and throughput bench
+//
+// cli.pro builds them as a console exe (Si5351_cli), the GUI exe runs them too but on Windows it has no console output
+
+#ifndef CLI_H
+#define CLI_H
+
+// true if the command line asks for one of the commands rather than the GUI
+bool cli_command(int argc, char *argv[]);
+
+// run the command, returns the process exit code
+int cli_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,40 @@
+# console build of the sweep/plan/selftest commands .. no GUI, so it can be scripted and its exit code checked
+# (shadow build it, or build it in its own directory, the GUI project's Makefile lives here too)
+
+QT       += core
+QT       -= gui
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = Si5351_cli
+
+SOURCES += \
+    cli.cpp \
+    climain.cpp \
+    i2cbus.cpp \
+    jointplan.cpp \
+    plancache.cpp \
+    plancost.cpp \
+    pllplan.cpp \
+    selftest.cpp \
+    si5351.cpp \
+    sweep.cpp \
+    writeseq.cpp
+
+HEADERS += \
+    cli.h \
+    i2cbus.h \
+    jointplan.h \
+    plancache.h \
+    plancost.h \
+    pllplan.h \
+    selftest.h \
+    si5351.h \
+    sweep.h \
+    writeseq.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
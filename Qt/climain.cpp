@@ -0,0 +1,19 @@
+// Si5351 I2C data decoder
+//
+// Console build of the command line commands (cli.pro) .. on Windows the GUI build is a windows subsystem exe, which
+// can't write to the console it's run from and isn't waited for
+
+#include <stdio.h>
+
+#include "cli.h"
+
+int main(int argc, char *argv[])
+{
+	if (!cli_command(argc, argv))
+	{
+		fprintf(stderr, "usage: %s sweep|plan|selftest [options] .. --help for a command's options\n", (argc > 0) ? argv[0] : "Si5351_cli");
+		return 1;
+	}
+
+	return cli_main(argc, argv);
+}
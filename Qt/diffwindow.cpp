@@ -0,0 +1,227 @@
+// Si5351 I2C data decoder
+//
+// Capture to capture diff window
+
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+#include "statehash.h"
+#include "statecatalog.h"
+#include "diffwindow.h"
+
+// ****************************************************************
+
+CaptureDiffThread::CaptureDiffThread(QObject *parent) :
+	QThread(parent),
+	m_a(nullptr),
+	m_catalog_a(nullptr),
+	m_b(nullptr),
+	m_catalog_b(nullptr),
+	m_cancel(false),
+	m_completed(false)
+{
+	m_diff.clear();
+}
+
+CaptureDiffThread::~CaptureDiffThread()
+{
+	cancel();
+}
+
+void CaptureDiffThread::start(const t_capture *a, const t_state_catalog *catalog_a, const t_capture *b, const t_state_catalog *catalog_b)
+{
+	cancel();
+
+	m_a         = a;
+	m_catalog_a = catalog_a;
+	m_b         = b;
+	m_catalog_b = catalog_b;
+	m_cancel    = false;
+	m_completed = false;
+
+	QThread::start(QThread::LowPriority);
+}
+
+void CaptureDiffThread::cancel()
+{
+	m_cancel = true;
+	wait();
+}
+
+void CaptureDiffThread::run()
+{
+	m_completed = capture_diff(*m_a, *m_catalog_a, *m_b, *m_catalog_b, m_diff, &m_cancel);
+}
+
+// ****************************************************************
+
+CaptureDiffListModel::CaptureDiffListModel(QObject *parent) :
+	QAbstractListModel(parent),
+	m_a(nullptr),
+	m_b(nullptr),
+	m_diff(nullptr)
+{
+}
+
+int CaptureDiffListModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid() || !m_diff)
+		return 0;
+	return (int)m_diff->edits.size();
+}
+
+QVariant CaptureDiffListModel::data(const QModelIndex &index, int role) const
+{
+	if (role != Qt::DisplayRole || !m_diff || !index.isValid())
+		return QVariant();
+
+	const int row = index.row();
+	if (row < 0 || row >= (int)m_diff->edits.size())
+		return QVariant();
+
+	const t_diff_op &op = m_diff->ops[m_diff->edits[row]];
+
+	QString s;
+	switch (op.type)
+	{
+		case DIFF_DELETE:
+			capture_line_text(*m_a, op.line_a, m_buf);
+			s.sprintf("-  A %6u           ", 1 + op.line_a);
+			break;
+		case DIFF_INSERT:
+			capture_line_text(*m_b, op.line_b, m_buf);
+			s.sprintf("+           B %6u  ", 1 + op.line_b);
+			break;
+		case DIFF_CHANGE:
+			capture_line_text(*m_a, op.line_a, m_buf);
+			s.sprintf("~  A %6u  B %6u  ", 1 + op.line_a, 1 + op.line_b);
+			s += QString::fromLatin1(m_buf.empty() ? "" : &m_buf[0], (int)m_buf.size()) + "   -> ";
+			capture_line_text(*m_b, op.line_b, m_buf);
+			break;
+		default:
+			return QVariant();
+	}
+
+	return s + QString::fromLatin1(m_buf.empty() ? "" : &m_buf[0], (int)m_buf.size());
+}
+
+void CaptureDiffListModel::setDiff(const t_capture *a, const t_capture *b, const t_capture_diff *diff)
+{
+	beginResetModel();
+	m_a    = a;
+	m_b    = b;
+	m_diff = diff;
+	endResetModel();
+}
+
+int CaptureDiffListModel::lineA(const int row) const
+{
+	if (!m_diff || row < 0 || row >= (int)m_diff->edits.size())
+		return -1;
+
+	const unsigned int i = m_diff->edits[row];
+
+	// an insert has no A line, use the A line before it
+	for (int k = (int)i; k >= 0; k--)
+		if (m_diff->ops[k].type != DIFF_INSERT)
+			return (int)m_diff->ops[k].line_a;
+
+	return -1;
+}
+
+// ****************************************************************
+
+CaptureDiffWindow::CaptureDiffWindow(const t_capture *a, const t_state_catalog *catalog_a, QWidget *parent) :
+	QWidget(parent, Qt::Window),
+	m_a(a),
+	m_catalog_a(catalog_a)
+{
+	setWindowTitle("Compare");
+
+	m_diff.clear();
+
+	m_thread = new CaptureDiffThread(this);
+	connect(m_thread, SIGNAL(finished()), this, SLOT(onDiffFinished()));
+
+	m_model = new CaptureDiffListModel(this);
+
+	m_summary_label = new QLabel(this);
+
+	m_list_view = new QListView(this);
+	m_list_view->setUniformItemSizes(true);
+	m_list_view->setModel(m_model);
+	connect(m_list_view, SIGNAL(clicked(QModelIndex)), this, SLOT(onListClicked(QModelIndex)));
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addWidget(m_summary_label);
+	layout->addWidget(m_list_view, 1);
+
+	resize(800, 500);
+}
+
+CaptureDiffWindow::~CaptureDiffWindow()
+{
+	m_thread->cancel();
+}
+
+void CaptureDiffWindow::compare(const QString &filename, t_capture &b)
+{
+	m_thread->cancel();
+
+	m_model->setDiff(nullptr, nullptr, nullptr);
+	m_diff.clear();
+
+	m_filename = filename;
+	std::swap(m_b, b);
+
+	{
+		t_state_hashes hashes;
+		hashes.build(m_b);
+		m_catalog_b.build(m_b, hashes);
+	}
+
+	setWindowTitle("Compare with " + m_filename);
+	m_summary_label->setText("Comparing ..");
+
+	m_thread->start(m_a, m_catalog_a, &m_b, &m_catalog_b);
+}
+
+// a divergence point .. -1 is before the first line
+static QString diffLineText(const int line)
+{
+	return (line < 0) ? QString("the reset state") : "line " + QString::number(1 + line);
+}
+
+void CaptureDiffWindow::onDiffFinished()
+{
+	if (m_thread->isRunning() || m_thread->cancelled())
+		return;	// a cancelled run finishing late
+
+	std::swap(m_diff, m_thread->result());
+	m_thread->result().clear();
+
+	m_model->setDiff(m_a, &m_b, &m_diff);
+
+	QString s;
+	s.sprintf("%u same, %u removed, %u added, %u changed", m_diff.equal, m_diff.deleted, m_diff.inserted, m_diff.changed);
+
+	if (m_diff.state_diverge_a < 0 && m_diff.state_diverge_b < 0)
+		s += "\nThe register states never diverge";
+	else
+		s += "\nRegister states first diverge at A " + diffLineText(m_diff.state_diverge_a) + ", B " + diffLineText(m_diff.state_diverge_b);
+
+	if (m_diff.freq_diverge_a < 0 && m_diff.freq_diverge_b < 0)
+		s += "\nThe PLL/CLK frequencies never diverge";
+	else
+		s += "\nPLL/CLK frequencies first diverge at A " + diffLineText(m_diff.freq_diverge_a) + ", B " + diffLineText(m_diff.freq_diverge_b);
+
+	m_summary_label->setText(s);
+}
+
+void CaptureDiffWindow::onListClicked(const QModelIndex &index)
+{
+	const int line = m_model->lineA(index.row());
+	if (line >= 0)
+		emit lineClicked(line);
+}
@@ -0,0 +1,114 @@
+// Si5351 I2C data decoder
+//
+// Capture to capture diff window
+
+#ifndef DIFFWINDOW_H
+#define DIFFWINDOW_H
+
+#include <QWidget>
+#include <QThread>
+#include <QAbstractListModel>
+#include <QLabel>
+#include <QListView>
+
+#include <atomic>
+#include <vector>
+
+#include "capture.h"
+#include "statecatalog.h"
+#include "capturediff.h"
+
+// runs the diff off the GUI thread
+class CaptureDiffThread : public QThread
+{
+	Q_OBJECT
+
+public:
+	CaptureDiffThread(QObject *parent = nullptr);
+	~CaptureDiffThread();
+
+	// the captures/catalogs must stay alive (and unchanged) until the thread has finished
+	void start(const t_capture *a, const t_state_catalog *catalog_a, const t_capture *b, const t_state_catalog *catalog_b);
+
+	void cancel();
+
+	bool cancelled() const { return !m_completed; }
+
+	t_capture_diff &result() { return m_diff; }
+
+protected:
+	void run() override;
+
+private:
+	const t_capture       *m_a;
+	const t_state_catalog *m_catalog_a;
+	const t_capture       *m_b;
+	const t_state_catalog *m_catalog_b;
+
+	std::atomic <bool> m_cancel;
+	bool               m_completed;
+
+	t_capture_diff m_diff;
+};
+
+// one row per edit, rendered on demand
+class CaptureDiffListModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+public:
+	CaptureDiffListModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+	void setDiff(const t_capture *a, const t_capture *b, const t_capture_diff *diff);
+
+	// the capture A line to seek to for a row
+	int lineA(const int row) const;
+
+private:
+	const t_capture      *m_a;
+	const t_capture      *m_b;
+	const t_capture_diff *m_diff;
+
+	mutable std::vector <char> m_buf;
+};
+
+class CaptureDiffWindow : public QWidget
+{
+	Q_OBJECT
+
+public:
+	// 'a' is the main window capture .. the window must be closed before it changes
+	CaptureDiffWindow(const t_capture *a, const t_state_catalog *catalog_a, QWidget *parent = nullptr);
+	~CaptureDiffWindow();
+
+	// takes over 'b'
+	void compare(const QString &filename, t_capture &b);
+
+signals:
+	void lineClicked(int line);
+
+private slots:
+	void onDiffFinished();
+
+	void onListClicked(const QModelIndex &index);
+
+private:
+	const t_capture       *m_a;
+	const t_state_catalog *m_catalog_a;
+
+	QString         m_filename;
+	t_capture       m_b;
+	t_state_catalog m_catalog_b;
+
+	CaptureDiffThread    *m_thread;
+	t_capture_diff        m_diff;
+	CaptureDiffListModel *m_model;
+
+	QLabel    *m_summary_label;
+	QListView *m_list_view;
+};
+
+#endif
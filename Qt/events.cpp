@@ -0,0 +1,208 @@
+// Si5351 I2C data decoder
+//
+// Sorted list of the interesting points of a capture .. frequency changes, output enable changes and PLL resets
+
+#include <algorithm>
+
+#include "si5351.h"
+#include "events.h"
+
+// ****************************************************************
+
+static bool event_less(const t_event &a, const t_event &b)
+{
+	if (a.line != b.line)
+		return a.line < b.line;
+	if (a.type != b.type)
+		return a.type < b.type;
+	return a.index < b.index;
+}
+
+static bool event_line_less(const t_event &e, const uint32_t line)
+{
+	return e.line < line;
+}
+
+void t_event_index::clear()
+{
+	events.clear();
+	for (int t = 0; t < EVENT_TYPES; t++)
+		type_events[t].clear();
+}
+
+void t_event_index::build(const t_capture &capture, const t_state_catalog &catalog)
+{
+	clear();
+
+	t_event e;
+
+	// ******************
+	// frequency changes .. only lines that change the state can change a frequency, the 1st line is compared
+	// against the power-on reset state (evaluated the same way the catalog does, 1 Hz reference),
+	// every PLL and output (the timeline only plots PLL-A/B and CLK-0 to 2)
+
+	if (catalog.line_state.size() == capture.lines())
+	{
+		uint8_t reset_regs[256];
+		si5351_reset_regs(reset_regs);
+
+		t_si5351_freqs reset_freqs;
+		si5351_freqs_reset(&reset_freqs);
+		si5351_freqs_update(&reset_freqs, reset_regs, 1.0, SI5351_DEP_ALL);
+
+		const t_si5351_freqs *prev = &reset_freqs;
+		for (unsigned int i = 0; i < capture.lines(); i++)
+		{
+			if (i > 0 && catalog.line_state[i] == catalog.line_state[i - 1])
+				continue;
+
+			const t_si5351_freqs &freqs = catalog.states[catalog.line_state[i]].freqs;
+			e.line = i;
+
+			e.type = EVENT_PLL_FREQ;
+			for (unsigned int pll = 0; pll < 2; pll++)
+			{
+				if (freqs.pll_Hz[pll] == prev->pll_Hz[pll])
+					continue;
+				e.index = (uint8_t)pll;
+				events.push_back(e);
+			}
+
+			e.type = EVENT_CLK_FREQ;
+			for (unsigned int clk = 0; clk < 8; clk++)
+			{
+				if (freqs.clk_Hz[clk] == prev->clk_Hz[clk])
+					continue;
+				e.index = (uint8_t)clk;
+				events.push_back(e);
+			}
+
+			prev = &freqs;
+		}
+	}
+
+	// ******************
+	// output enable transitions and PLL resets
+
+	uint8_t output_enable = 0;
+	for (unsigned int i = 0; i < si5351_reg_list_count; i++)
+		if (si5351_reg_list[i].addr == SI5351_REG_OUTPUT_ENABLE_CONTROL)
+			output_enable = si5351_reg_list[i].reset_value;
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		int addr = (size > 0) ? values[0] : 256;
+		for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+		{
+			const uint8_t value = values[k];
+
+			if (addr == SI5351_REG_OUTPUT_ENABLE_CONTROL)
+			{
+				if (value != output_enable)
+				{
+					e.line  = i;
+					e.type  = EVENT_OUTPUT_ENABLE;
+					e.index = value ^ output_enable;
+					events.push_back(e);
+					output_enable = value;
+				}
+			}
+			else
+			if (addr == SI5351_REG_PLL_RESET)
+			{
+				if (value & 0xa0)
+				{
+					e.line  = i;
+					e.type  = EVENT_PLL_RESET;
+					e.index = value;
+					events.push_back(e);
+				}
+			}
+		}
+	}
+
+	std::sort(events.begin(), events.end(), event_less);
+
+	for (unsigned int i = 0; i < events.size(); i++)
+		type_events[events[i].type].push_back(i);
+}
+
+int t_event_index::next(const int line, const uint32_t mask) const
+{
+	const uint32_t from = (line < 0) ? 0 : (uint32_t)line + 1;
+
+	if ((mask & EVENT_MASK_ALL) == EVENT_MASK_ALL)
+	{
+		const std::vector <t_event>::const_iterator it = std::lower_bound(events.begin(), events.end(), from, event_line_less);
+		return (it != events.end()) ? (int)(it - events.begin()) : -1;
+	}
+
+	// earliest of the per type searches
+	int best = -1;
+	for (int t = 0; t < EVENT_TYPES; t++)
+	{
+		if ((mask & EVENT_MASK(t)) == 0)
+			continue;
+
+		const std::vector <uint32_t> &list = type_events[t];
+
+		unsigned int lo = 0;
+		unsigned int hi = (unsigned int)list.size();
+		while (lo < hi)
+		{
+			const unsigned int mid = (lo + hi) / 2;
+			if (events[list[mid]].line < from)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		if (lo < list.size() && (best < 0 || (int)list[lo] < best))
+			best = (int)list[lo];
+	}
+
+	return best;
+}
+
+int t_event_index::prev(const int line, const uint32_t mask) const
+{
+	if (line <= 0)
+		return -1;
+
+	const uint32_t before = (uint32_t)line;
+
+	if ((mask & EVENT_MASK_ALL) == EVENT_MASK_ALL)
+	{
+		const std::vector <t_event>::const_iterator it = std::lower_bound(events.begin(), events.end(), before, event_line_less);
+		return (it != events.begin()) ? (int)(it - events.begin()) - 1 : -1;
+	}
+
+	// latest of the per type searches
+	int best = -1;
+	for (int t = 0; t < EVENT_TYPES; t++)
+	{
+		if ((mask & EVENT_MASK(t)) == 0)
+			continue;
+
+		const std::vector <uint32_t> &list = type_events[t];
+
+		unsigned int lo = 0;
+		unsigned int hi = (unsigned int)list.size();
+		while (lo < hi)
+		{
+			const unsigned int mid = (lo + hi) / 2;
+			if (events[list[mid]].line < before)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		if (lo > 0 && (int)list[lo - 1] > best)
+			best = (int)list[lo - 1];
+	}
+
+	return best;
+}
@@ -0,0 +1,46 @@
+// Si5351 I2C data decoder
+//
+// Sorted list of the interesting points of a capture .. frequency changes, output enable changes and PLL resets
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+#include "statecatalog.h"
+
+#define EVENT_PLL_FREQ          0	// PLL-A/B frequency changed, 'index' = PLL
+#define EVENT_CLK_FREQ          1	// CLK-0 to 7 frequency changed, 'index' = CLK
+#define EVENT_OUTPUT_ENABLE     2	// output enable register bits changed, 'index' = the toggled bits
+#define EVENT_PLL_RESET         3	// PLL reset register written with a reset bit set, 'index' = the value written
+#define EVENT_TYPES             4
+
+#define EVENT_MASK(type)        (1u << (type))
+#define EVENT_MASK_ALL          ((1u << EVENT_TYPES) - 1)
+
+struct t_event
+{
+	uint32_t line;
+	uint8_t  type;
+	uint8_t  index;
+};
+
+struct t_event_index
+{
+	std::vector <t_event> events;                 // sorted by line
+
+	std::vector <uint32_t> type_events[EVENT_TYPES];  // per type, indexes into 'events' (so also sorted by line)
+
+	void clear();
+
+	// the frequency change events are taken from the catalog's per state frequencies, the register events from the capture
+	void build(const t_capture &capture, const t_state_catalog &catalog);
+
+	// the first event after/last event before 'line' whose type is in 'mask', -1 if none
+	int next(const int line, const uint32_t mask = EVENT_MASK_ALL) const;
+	int prev(const int line, const uint32_t mask = EVENT_MASK_ALL) const;
+};
+
+#endif
@@ -0,0 +1,360 @@
+// Si5351 I2C data decoder
+//
+// Frequency-over-time plot of the PLL/CLK outputs, one lane per output
+//
+// every pixel column is drawn as a single min/max bar taken from the series LOD pyramids,
+// so the paint cost depends on the widget width, not on the number of capture lines
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "si5351.h"
+#include "freqplotwidget.h"
+
+#define PLOT_LABEL_WIDTH    70    // left margin for the lane names
+#define PLOT_AXIS_HEIGHT    16    // bottom margin for the x axis
+#define PLOT_LANE_GAP       3
+#define PLOT_MIN_VIEW_LINES 8     // max zoom in
+
+static const char *plot_lane_names[TIMELINE_SERIES_COUNT] = {"PLL-A", "PLL-B", "CLK-0", "CLK-1", "CLK-2"};
+
+static QString plot_freq_string(const double Hz)
+{
+	QString s;
+	if (Hz >= 1e6)
+		s.sprintf("%0.6f MHz", Hz / 1e6);
+	else
+		s.sprintf("%0.3f kHz", Hz / 1e3);
+	return s;
+}
+
+// ****************************************************************
+
+FreqPlotWidget::FreqPlotWidget(QWidget *parent) :
+	QWidget(parent),
+	m_timeline(nullptr),
+	m_xtal_Hz(SI5351_XTAL_HZ),
+	m_cursor_line(-1),
+	m_view_x0(0),
+	m_view_x1(1),
+	m_dragging(false),
+	m_press_x(0),
+	m_drag_x(0)
+{
+	setMinimumHeight(60);
+	setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+QSize FreqPlotWidget::sizeHint() const
+{
+	return QSize(400, 160);
+}
+
+void FreqPlotWidget::setTimeline(const t_freq_timeline *timeline)
+{
+	m_timeline    = timeline;
+	m_cursor_line = -1;
+	fullRange(m_view_x0, m_view_x1);
+	update();
+}
+
+void FreqPlotWidget::setXtalHz(const double xtal_Hz)
+{
+	m_xtal_Hz = xtal_Hz;
+	update();
+}
+
+void FreqPlotWidget::setCursorLine(const int line)
+{
+	if (m_cursor_line == line)
+		return;
+	m_cursor_line = line;
+	update();
+}
+
+bool FreqPlotWidget::timeAxis() const
+{
+	return m_timeline && !m_timeline->line_time.empty() && m_timeline->line_time.back() > m_timeline->line_time.front();
+}
+
+void FreqPlotWidget::fullRange(double &x0, double &x1) const
+{
+	x0 = 0;
+	x1 = 1;
+
+	if (!m_timeline || m_timeline->lines == 0)
+		return;
+
+	if (timeAxis())
+	{
+		x0 = m_timeline->line_time.front();
+		x1 = m_timeline->line_time.back();
+	}
+	else
+	{
+		x0 = 0;
+		x1 = m_timeline->lines;
+	}
+}
+
+double FreqPlotWidget::pixelToX(const int px) const
+{
+	const int w = width() - PLOT_LABEL_WIDTH;
+	if (w <= 0)
+		return m_view_x0;
+	return m_view_x0 + ((m_view_x1 - m_view_x0) * (px - PLOT_LABEL_WIDTH)) / w;
+}
+
+int FreqPlotWidget::xToPixel(const double x) const
+{
+	const int w = width() - PLOT_LABEL_WIDTH;
+	if (m_view_x1 <= m_view_x0)
+		return PLOT_LABEL_WIDTH;
+	return PLOT_LABEL_WIDTH + (int)floor(((x - m_view_x0) * w) / (m_view_x1 - m_view_x0));
+}
+
+unsigned int FreqPlotWidget::xToLine(const double x) const
+{
+	if (!m_timeline || m_timeline->lines == 0 || x <= 0.0)
+		return 0;
+
+	if (timeAxis())
+		return m_timeline->lineAtTime(x);
+
+	return (x >= m_timeline->lines) ? m_timeline->lines : (unsigned int)x;
+}
+
+double FreqPlotWidget::lineToX(const unsigned int line) const
+{
+	if (timeAxis())
+		return m_timeline->line_time[line];
+	return line;
+}
+
+void FreqPlotWidget::clampView()
+{
+	double x0;
+	double x1;
+	fullRange(x0, x1);
+
+	double span = m_view_x1 - m_view_x0;
+
+	double min_span = PLOT_MIN_VIEW_LINES;
+	if (timeAxis())
+		min_span = ((x1 - x0) * PLOT_MIN_VIEW_LINES) / m_timeline->lines;
+
+	if (span < min_span)
+		span = min_span;
+	if (span > (x1 - x0))
+		span = x1 - x0;
+
+	if (m_view_x0 < x0)
+		m_view_x0 = x0;
+	if (m_view_x0 + span > x1)
+		m_view_x0 = x1 - span;
+	m_view_x1 = m_view_x0 + span;
+}
+
+void FreqPlotWidget::paintEvent(QPaintEvent *event)
+{
+	Q_UNUSED(event);
+
+	QPainter painter(this);
+
+	const QColor back_colour(255, 255, 255);
+	const QColor lane_colour(245, 245, 245);
+	const QColor text_colour(0, 0, 0);
+	const QColor plot_colour(0, 0, 200);
+	const QColor cursor_colour(220, 0, 0);
+
+	painter.fillRect(rect(), back_colour);
+
+	if (!m_timeline || m_timeline->lines == 0 || width() <= PLOT_LABEL_WIDTH)
+		return;
+
+	const int lane_h = (height() - PLOT_AXIS_HEIGHT) / TIMELINE_SERIES_COUNT;
+	if (lane_h <= PLOT_LANE_GAP * 2)
+		return;
+
+	const int plot_w = width() - PLOT_LABEL_WIDTH;
+
+	// the line range covered by each pixel column
+	std::vector <unsigned int> col_line(plot_w + 1);
+	for (int px = 0; px <= plot_w; px++)
+		col_line[px] = xToLine(pixelToX(PLOT_LABEL_WIDTH + px));
+
+	for (int s = 0; s < TIMELINE_SERIES_COUNT; s++)
+	{
+		const t_freq_series &ser = m_timeline->series[s];
+
+		const int top = s * lane_h;
+		const int bot = top + lane_h - PLOT_LANE_GAP;
+
+		painter.fillRect(PLOT_LABEL_WIDTH, top, plot_w, lane_h - PLOT_LANE_GAP, lane_colour);
+
+		painter.setPen(text_colour);
+		painter.drawText(QRect(2, top, PLOT_LABEL_WIDTH - 4, lane_h - PLOT_LANE_GAP), Qt::AlignLeft | Qt::AlignVCenter, plot_lane_names[s]);
+
+		if (ser.value.empty())
+			continue;
+
+		// lane y scale from the visible min/max
+		const int i_first = std::max(0, ser.indexAt(col_line[0]));
+		const int i_last  = ser.indexAt((col_line[plot_w] > 0) ? col_line[plot_w] - 1 : 0) + 1;
+
+		float lane_min;
+		float lane_max;
+		if (i_last <= i_first || !ser.rangeMinMax(i_first, i_last, lane_min, lane_max))
+			continue;
+
+		double lo = lane_min;
+		double hi = lane_max;
+		if (hi - lo < hi * 1e-9)
+		{	// flat line, centre it
+			lo = hi * (1.0 - 1e-6);
+			hi = hi * (1.0 + 1e-6);
+		}
+
+		const double y_scale = (bot - top - 4) / (hi - lo);
+
+		painter.setPen(plot_colour);
+
+		for (int px = 0; px < plot_w; px++)
+		{
+			unsigned int l0 = col_line[px];
+			unsigned int l1 = col_line[px + 1];
+			if (l1 <= l0)
+				l1 = l0 + 1;	// zoomed in past one line per pixel
+
+			const int i0 = std::max(0, ser.indexAt(l0));
+			const int i1 = ser.indexAt(l1 - 1) + 1;
+
+			float mn;
+			float mx;
+			if (i1 <= i0 || !ser.rangeMinMax(i0, i1, mn, mx))
+				continue;	// output off
+
+			const int y0 = bot - 2 - (int)((mn - lo) * y_scale);
+			const int y1 = bot - 2 - (int)((mx - lo) * y_scale);
+			painter.drawLine(PLOT_LABEL_WIDTH + px, y0, PLOT_LABEL_WIDTH + px, y1);
+		}
+
+		painter.setPen(text_colour);
+		painter.drawText(QRect(PLOT_LABEL_WIDTH + 4, top, plot_w - 8, lane_h - PLOT_LANE_GAP), Qt::AlignRight | Qt::AlignTop, plot_freq_string(hi * m_xtal_Hz));
+		if (lane_max > lane_min)
+			painter.drawText(QRect(PLOT_LABEL_WIDTH + 4, top, plot_w - 8, lane_h - PLOT_LANE_GAP), Qt::AlignRight | Qt::AlignBottom, plot_freq_string(lo * m_xtal_Hz));
+	}
+
+	// x axis
+	{
+		QString s;
+		const int y = height() - PLOT_AXIS_HEIGHT;
+
+		painter.setPen(text_colour);
+		if (timeAxis())
+		{
+			s.sprintf("%0.6f s", m_view_x0);
+			painter.drawText(QRect(PLOT_LABEL_WIDTH, y, plot_w, PLOT_AXIS_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, s);
+			s.sprintf("%0.6f s", m_view_x1);
+			painter.drawText(QRect(PLOT_LABEL_WIDTH, y, plot_w, PLOT_AXIS_HEIGHT), Qt::AlignRight | Qt::AlignVCenter, s);
+		}
+		else
+		{
+			painter.drawText(QRect(PLOT_LABEL_WIDTH, y, plot_w, PLOT_AXIS_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, "line " + QString::number(1 + (int)m_view_x0));
+			painter.drawText(QRect(PLOT_LABEL_WIDTH, y, plot_w, PLOT_AXIS_HEIGHT), Qt::AlignRight | Qt::AlignVCenter, "line " + QString::number((int)m_view_x1));
+		}
+	}
+
+	// selected line cursor
+	if (m_cursor_line >= 0 && m_cursor_line < (int)m_timeline->lines)
+	{
+		const int x = xToPixel(lineToX(m_cursor_line));
+		if (x >= PLOT_LABEL_WIDTH && x < width())
+		{
+			painter.setPen(cursor_colour);
+			painter.drawLine(x, 0, x, height() - PLOT_AXIS_HEIGHT);
+		}
+	}
+}
+
+void FreqPlotWidget::mousePressEvent(QMouseEvent *event)
+{
+	if (event->button() != Qt::LeftButton)
+		return;
+
+	m_dragging = true;
+	m_press_x  = event->x();
+	m_drag_x   = event->x();
+}
+
+void FreqPlotWidget::mouseMoveEvent(QMouseEvent *event)
+{
+	if (!m_dragging || !m_timeline)
+		return;
+
+	// pan
+	const double dx = pixelToX(m_drag_x) - pixelToX(event->x());
+	m_view_x0 += dx;
+	m_view_x1 += dx;
+	m_drag_x = event->x();
+
+	clampView();
+	update();
+}
+
+void FreqPlotWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+	if (!m_dragging)
+		return;
+
+	m_dragging = false;
+
+	if (!m_timeline || m_timeline->lines == 0)
+		return;
+
+	if (abs(event->x() - m_press_x) > 3 || event->x() < PLOT_LABEL_WIDTH)
+		return;	// was a drag
+
+	// seek to the clicked line
+	unsigned int line = xToLine(pixelToX(event->x()));
+	if (line >= m_timeline->lines)
+		line = m_timeline->lines - 1;
+
+	emit lineClicked((int)line);
+}
+
+void FreqPlotWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+	Q_UNUSED(event);
+
+	// zoom out to the whole capture
+	fullRange(m_view_x0, m_view_x1);
+	update();
+}
+
+void FreqPlotWidget::wheelEvent(QWheelEvent *event)
+{
+	if (!m_timeline || m_timeline->lines == 0)
+		return;
+
+	const int delta = event->angleDelta().y();
+	if (delta == 0)
+		return;
+
+	// zoom about the mouse position
+	const double x     = pixelToX(event->pos().x());
+	const double scale = (delta > 0) ? 0.8 : 1.25;
+
+	m_view_x0 = x - ((x - m_view_x0) * scale);
+	m_view_x1 = x + ((m_view_x1 - x) * scale);
+
+	clampView();
+	update();
+}
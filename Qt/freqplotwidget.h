@@ -0,0 +1,69 @@
+// Si5351 I2C data decoder
+//
+// Frequency-over-time plot of the PLL/CLK outputs, one lane per output
+
+#ifndef FREQPLOTWIDGET_H
+#define FREQPLOTWIDGET_H
+
+#include <QWidget>
+
+#include "timeline.h"
+
+class FreqPlotWidget : public QWidget
+{
+	Q_OBJECT
+
+public:
+	FreqPlotWidget(QWidget *parent = nullptr);
+
+	// the timeline must stay alive (and unchanged) until the next setTimeline() call
+	void setTimeline(const t_freq_timeline *timeline);
+
+	void setXtalHz(const double xtal_Hz);
+
+	void setCursorLine(const int line);
+
+	QSize sizeHint() const override;
+
+signals:
+	void lineClicked(int line);
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void mousePressEvent(QMouseEvent *event) override;
+	void mouseMoveEvent(QMouseEvent *event) override;
+	void mouseReleaseEvent(QMouseEvent *event) override;
+	void mouseDoubleClickEvent(QMouseEvent *event) override;
+	void wheelEvent(QWheelEvent *event) override;
+
+private:
+	const t_freq_timeline *m_timeline;
+
+	double m_xtal_Hz;
+
+	int m_cursor_line;
+
+	// the visible x range .. lines, or seconds if the capture is time stamped
+	double m_view_x0;
+	double m_view_x1;
+
+	bool m_dragging;
+	int  m_press_x;
+	int  m_drag_x;
+
+	bool timeAxis() const;
+
+	void fullRange(double &x0, double &x1) const;
+
+	double pixelToX(const int px) const;
+
+	int xToPixel(const double x) const;
+
+	unsigned int xToLine(const double x) const;
+
+	double lineToX(const unsigned int line) const;
+
+	void clampView();
+};
+
+#endif
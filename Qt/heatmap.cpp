@@ -0,0 +1,135 @@
+// Si5351 I2C data decoder
+//
+// Register write density grid (register x capture position) with power of 2 column reductions
+
+#include <string.h>
+
+#include "si5351.h"
+#include "heatmap.h"
+
+// ****************************************************************
+
+void t_write_heatmap::clear()
+{
+	lines            = 0;
+	lines_per_column = 1;
+	levels.clear();
+}
+
+unsigned int t_write_heatmap::rows() const
+{
+	return si5351_reg_list_count;
+}
+
+void t_write_heatmap::build(const t_capture &capture)
+{
+	clear();
+
+	lines = capture.lines();
+	if (lines == 0)
+		return;
+
+	lines_per_column = (lines + HEATMAP_MAX_COLUMNS - 1) / HEATMAP_MAX_COLUMNS;
+
+	const unsigned int rows = si5351_reg_list_count;
+
+	// register address to grid row
+	int addr_row[256];
+	for (int i = 0; i < 256; i++)
+		addr_row[i] = -1;
+	for (unsigned int i = 0; i < rows; i++)
+		addr_row[si5351_reg_list[i].addr] = (int)i;
+
+	// ******************
+	// level 0 .. a single pass over the capture
+
+	t_heatmap_level level;
+	level.columns    = (lines + lines_per_column - 1) / lines_per_column;
+	level.max_writes = 0;
+	level.writes.assign(rows * level.columns, 0);
+	level.changes.assign(rows * level.columns, 0);
+
+	uint8_t regs[256];
+	si5351_reset_regs(regs);
+
+	for (unsigned int i = 0; i < lines; i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		if (size == 0)
+			continue;
+
+		// clear the PLL self clearing bits
+		regs[SI5351_REG_PLL_RESET] &= 0x5f;
+
+		const unsigned int col = i / lines_per_column;
+
+		int addr = values[0];
+		for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+		{
+			const int row = addr_row[addr];
+			if (row >= 0)
+			{
+				level.writes[(row * level.columns) + col]++;
+				if (regs[addr] != values[k])
+					level.changes[(row * level.columns) + col]++;
+			}
+			regs[addr] = values[k];
+		}
+	}
+
+	for (unsigned int i = 0; i < level.writes.size(); i++)
+		if (level.max_writes < level.writes[i])
+			level.max_writes = level.writes[i];
+
+	levels.push_back(level);
+
+	// ******************
+	// each further level sums pairs of columns of the one below
+
+	while (levels.back().columns > 1)
+	{
+		const t_heatmap_level &src = levels.back();
+
+		t_heatmap_level dst;
+		dst.columns    = (src.columns + 1) / 2;
+		dst.max_writes = 0;
+		dst.writes.assign(rows * dst.columns, 0);
+		dst.changes.assign(rows * dst.columns, 0);
+
+		for (unsigned int row = 0; row < rows; row++)
+		{
+			const uint32_t *sw = &src.writes[row * src.columns];
+			const uint32_t *sc = &src.changes[row * src.columns];
+			uint32_t       *dw = &dst.writes[row * dst.columns];
+			uint32_t       *dc = &dst.changes[row * dst.columns];
+
+			for (unsigned int col = 0; col < src.columns; col++)
+			{
+				dw[col >> 1] += sw[col];
+				dc[col >> 1] += sc[col];
+			}
+
+			for (unsigned int col = 0; col < dst.columns; col++)
+				if (dst.max_writes < dw[col])
+					dst.max_writes = dw[col];
+		}
+
+		levels.push_back(dst);
+	}
+}
+
+unsigned int t_write_heatmap::levelFor(const unsigned int columns) const
+{
+	unsigned int level = 0;
+	while (level + 1 < levels.size() && levels[level + 1].columns >= columns)
+		level++;
+	return level;
+}
+
+unsigned int t_write_heatmap::columnLine(const unsigned int level, const unsigned int column) const
+{
+	const uint64_t line = ((uint64_t)column << level) * lines_per_column;
+	return (line >= lines) ? lines : (unsigned int)line;
+}
@@ -0,0 +1,45 @@
+// Si5351 I2C data decoder
+//
+// Register write density grid (register x capture position) with power of 2 column reductions
+
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+
+#define HEATMAP_MAX_COLUMNS     4096	// level 0 width .. long captures get several lines per column
+
+// one resolution level .. row major, one row per si5351_reg_list[] entry (same order as the register table)
+struct t_heatmap_level
+{
+	unsigned int           columns;
+	std::vector <uint32_t> writes;     // number of writes to the register within the column
+	std::vector <uint32_t> changes;    // number of those writes that changed the register value
+	uint32_t               max_writes;
+};
+
+struct t_write_heatmap
+{
+	unsigned int lines;
+	unsigned int lines_per_column;     // level 0
+
+	// level k has ceil(level 0 columns / 2^k) columns
+	std::vector <t_heatmap_level> levels;
+
+	void clear();
+
+	void build(const t_capture &capture);
+
+	unsigned int rows() const;
+
+	// the coarsest level that still has at least 'columns' columns (level 0 if none do)
+	unsigned int levelFor(const unsigned int columns) const;
+
+	// first capture line of a column of a level
+	unsigned int columnLine(const unsigned int level, const unsigned int column) const;
+};
+
+#endif
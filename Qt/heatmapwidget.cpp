@@ -0,0 +1,171 @@
+// Si5351 I2C data decoder
+//
+// Register write heatmap .. register down, capture position across
+//
+// the image is rendered from the heatmap level closest to the widget width and then
+// just stretched on each paint, the capture itself is never walked here
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+
+#include <math.h>
+
+#include "si5351.h"
+#include "heatmapwidget.h"
+
+// ****************************************************************
+
+HeatmapWidget::HeatmapWidget(QWidget *parent) :
+	QWidget(parent),
+	m_heatmap(nullptr),
+	m_cursor_line(-1),
+	m_image_level(-1)
+{
+	setMinimumHeight(60);
+	setMouseTracking(true);
+	setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+QSize HeatmapWidget::sizeHint() const
+{
+	return QSize(400, 220);
+}
+
+void HeatmapWidget::setHeatmap(const t_write_heatmap *heatmap)
+{
+	m_heatmap     = heatmap;
+	m_cursor_line = -1;
+	m_image       = QImage();
+	m_image_level = -1;
+	update();
+}
+
+void HeatmapWidget::setCursorLine(const int line)
+{
+	if (m_cursor_line == line)
+		return;
+	m_cursor_line = line;
+	update();
+}
+
+void HeatmapWidget::renderLevel(const unsigned int level)
+{
+	const t_heatmap_level &lvl  = m_heatmap->levels[level];
+	const unsigned int     rows = m_heatmap->rows();
+
+	m_image       = QImage((int)lvl.columns, (int)rows, QImage::Format_RGB32);
+	m_image_level = (int)level;
+
+	const double log_max = log(1.0 + lvl.max_writes);
+
+	for (unsigned int row = 0; row < rows; row++)
+	{
+		uint32_t       *pix     = (uint32_t *)m_image.scanLine(row);
+		const uint32_t *writes  = &lvl.writes[row * lvl.columns];
+		const uint32_t *changes = &lvl.changes[row * lvl.columns];
+
+		for (unsigned int col = 0; col < lvl.columns; col++)
+		{
+			if (writes[col] == 0 || log_max <= 0.0)
+			{
+				pix[col] = 0xffffffff;
+				continue;
+			}
+
+			// brightness from the write density, blue = rewrites of the same value .. red = value changes
+			const double density = log(1.0 + writes[col]) / log_max;
+			const double changed = (double)changes[col] / writes[col];
+
+			const double r = 255.0 * changed;
+			const double b = 255.0 * (1.0 - changed);
+
+			const int red   = (int)(255.0 - ((255.0 - r)   * density));
+			const int green = (int)(255.0 - ((255.0 - 0.0) * density));
+			const int blue  = (int)(255.0 - ((255.0 - b)   * density));
+
+			pix[col] = 0xff000000u | ((uint32_t)red << 16) | ((uint32_t)green << 8) | (uint32_t)blue;
+		}
+	}
+}
+
+bool HeatmapWidget::cellAt(const int x, const int y, unsigned int &column, unsigned int &row) const
+{
+	if (!m_heatmap || m_heatmap->levels.empty() || width() <= 0 || height() <= 0)
+		return false;
+	if (x < 0 || x >= width() || y < 0 || y >= height())
+		return false;
+
+	// always level 0 for the look up .. the finest detail
+	column = (unsigned int)(((uint64_t)x * m_heatmap->levels[0].columns) / width());
+	row    = (unsigned int)(((uint64_t)y * m_heatmap->rows()) / height());
+	return true;
+}
+
+void HeatmapWidget::paintEvent(QPaintEvent *event)
+{
+	Q_UNUSED(event);
+
+	QPainter painter(this);
+
+	painter.fillRect(rect(), QColor(255, 255, 255));
+
+	if (!m_heatmap || m_heatmap->levels.empty())
+		return;
+
+	const unsigned int level = m_heatmap->levelFor(width());
+	if ((int)level != m_image_level)
+		renderLevel(level);
+
+	painter.drawImage(rect(), m_image);
+
+	// selected line cursor
+	if (m_cursor_line >= 0 && m_cursor_line < (int)m_heatmap->lines)
+	{
+		const int x = (int)(((uint64_t)m_cursor_line * width()) / m_heatmap->lines);
+		painter.setPen(QColor(0, 160, 0));
+		painter.drawLine(x, 0, x, height());
+	}
+}
+
+void HeatmapWidget::mouseMoveEvent(QMouseEvent *event)
+{
+	unsigned int col;
+	unsigned int row;
+
+	if (!cellAt(event->x(), event->y(), col, row))
+	{
+		setToolTip("");
+		return;
+	}
+
+	const t_heatmap_level &lvl     = m_heatmap->levels[0];
+	const unsigned int     line    = m_heatmap->columnLine(0, col);
+	const unsigned int     line_to = m_heatmap->columnLine(0, col + 1);
+
+	QString s;
+	s.sprintf("%3d %s\nlines %u to %u\n%u writes, %u changed the value",
+		si5351_reg_list[row].addr,
+		si5351_reg_list[row].name,
+		1 + line,
+		line_to,
+		lvl.writes[(row * lvl.columns) + col],
+		lvl.changes[(row * lvl.columns) + col]);
+	setToolTip(s);
+}
+
+void HeatmapWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+	unsigned int col;
+	unsigned int row;
+
+	if (event->button() != Qt::LeftButton || !cellAt(event->x(), event->y(), col, row))
+		return;
+
+	// seek to the first line of the column
+	unsigned int line = m_heatmap->columnLine(0, col);
+	if (line >= m_heatmap->lines)
+		line = m_heatmap->lines - 1;
+
+	emit lineClicked((int)line);
+}
@@ -0,0 +1,49 @@
+// Si5351 I2C data decoder
+//
+// Register write heatmap .. register down, capture position across
+
+#ifndef HEATMAPWIDGET_H
+#define HEATMAPWIDGET_H
+
+#include <QWidget>
+#include <QImage>
+
+#include "heatmap.h"
+
+class HeatmapWidget : public QWidget
+{
+	Q_OBJECT
+
+public:
+	HeatmapWidget(QWidget *parent = nullptr);
+
+	// the heatmap must stay alive (and unchanged) until the next setHeatmap() call
+	void setHeatmap(const t_write_heatmap *heatmap);
+
+	void setCursorLine(const int line);
+
+	QSize sizeHint() const override;
+
+signals:
+	void lineClicked(int line);
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void mouseMoveEvent(QMouseEvent *event) override;
+	void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+	const t_write_heatmap *m_heatmap;
+
+	int m_cursor_line;
+
+	// the rendered level, only redone when the level needed changes
+	QImage m_image;
+	int    m_image_level;
+
+	void renderLevel(const unsigned int level);
+
+	bool cellAt(const int x, const int y, unsigned int &column, unsigned int &row) const;
+};
+
+#endif
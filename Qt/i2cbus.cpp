@@ -0,0 +1,29 @@
+// Si5351 I2C data decoder
+//
+// I2C bus timing model
+
+#include "i2cbus.h"
+
+uint32_t i2c_write_clocks(const unsigned int bytes)
+{
+	return I2C_START_BITS + (I2C_BITS_PER_BYTE * (1 + bytes)) + I2C_STOP_BITS;
+}
+
+double i2c_write_secs(const unsigned int bytes, const double scl_Hz)
+{
+	return (scl_Hz > 0.0) ? i2c_write_clocks(bytes) / scl_Hz : 0.0;
+}
+
+double i2c_bus_free_secs(const double scl_Hz)
+{
+	if (scl_Hz <= 100000.0)
+		return 4.7e-6;	// standard mode
+	if (scl_Hz <= 400000.0)
+		return 1.3e-6;	// fast mode
+	return 0.5e-6;	// fast mode plus
+}
+
+double i2c_transaction_overhead_secs(const double scl_Hz)
+{
+	return i2c_write_secs(1, scl_Hz) + i2c_bus_free_secs(scl_Hz);
+}
@@ -0,0 +1,27 @@
+// Si5351 I2C data decoder
+//
+// I2C bus timing model
+
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+#include <stdint.h>
+
+#define I2C_BITS_PER_BYTE           9	// 8 data bits + ACK/NACK
+#define I2C_START_BITS              1
+#define I2C_STOP_BITS               1
+
+// SCL clock periods of a write transaction .. START, device address, 'bytes' bytes (the register address and the data), STOP
+uint32_t i2c_write_clocks(const unsigned int bytes);
+
+// the same in seconds at a SCL rate
+double i2c_write_secs(const unsigned int bytes, const double scl_Hz);
+
+// minimum bus free time between a STOP and the next START (t_BUF) for the mode the SCL rate falls in
+double i2c_bus_free_secs(const double scl_Hz);
+
+// cost of starting another transaction rather than carrying on with the current one .. START, device address,
+// register address, STOP and the bus free time
+double i2c_transaction_overhead_secs(const double scl_Hz);
+
+#endif
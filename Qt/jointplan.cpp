@@ -0,0 +1,279 @@
+// Si5351 I2C data decoder
+//
+// Joint multi-output frequency planner
+
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "si5351.h"
+#include "jointplan.h"
+
+// ****************************************************************
+
+// a + (b / c) compared exactly .. the values are well under 2^64 after the cross multiply
+static bool joint_plan_frac_higher(const t_pll_frac &f1, const t_pll_frac &f2)
+{
+	const uint64_t n1 = ((uint64_t)f1.a * f1.c) + f1.b;
+	const uint64_t n2 = ((uint64_t)f2.a * f2.c) + f2.b;
+	return (n1 * f2.c) > (n2 * f1.c);
+}
+
+static bool joint_plan_frac_same(const t_pll_frac &f1, const t_pll_frac &f2)
+{
+	return f1.a == f2.a && f1.b == f2.b && f1.c == f2.c;
+}
+
+static void joint_plan_add_vco(std::vector <t_pll_frac> &pool, const uint32_t ref_Hz, const uint64_t vco_Hz, const int frac_mode)
+{
+	if (vco_Hz < SI5351_PLL_VCO_MIN_HZ || vco_Hz > SI5351_PLL_VCO_MAX_HZ)
+		return;
+
+	t_pll_frac frac;
+	pll_calc_pll(ref_Hz, (uint32_t)vco_Hz, &frac.a, &frac.b, &frac.c, frac_mode);
+	pool.push_back(frac);
+}
+
+// the candidate VCO frequencies .. highest first so the higher VCO wins a tie
+static void joint_plan_pool(std::vector <t_pll_frac> &pool, const uint32_t ref_Hz, const t_joint_output *outputs, const int frac_mode)
+{
+	pool.clear();
+
+	// integer PLL
+	for (uint32_t a = 15; a <= 90; a++)
+		joint_plan_add_vco(pool, ref_Hz, (uint64_t)ref_Hz * a, frac_mode);
+
+	// an even integer multisynth for each output
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		const uint32_t freq_Hz = outputs[clk].freq_Hz;
+		if (freq_Hz == 0)
+			continue;
+
+		if (clk < 6)
+		{
+			uint64_t ms_Hz = freq_Hz;
+			while (ms_Hz < SI5351_MS_MIN_HZ && ms_Hz < ((uint64_t)freq_Hz << 7))
+				ms_Hz <<= 1;
+
+			joint_plan_add_vco(pool, ref_Hz, ms_Hz * 4, frac_mode);     // divide by 4 mode
+
+			uint64_t div = (SI5351_PLL_VCO_MIN_HZ + ms_Hz - 1) / ms_Hz;
+			div = std::max <uint64_t> (8, div + (div & 1));
+			for ( ; div <= 2048 && ms_Hz * div <= SI5351_PLL_VCO_MAX_HZ; div += 2)
+				joint_plan_add_vco(pool, ref_Hz, ms_Hz * div, frac_mode);
+		}
+		else
+		{	// multisynth 6/7 are even integer only, through any R-divider
+			for (unsigned int r_div = 0; r_div <= 7; r_div++)
+			{
+				const uint64_t ms_Hz = (uint64_t)freq_Hz << r_div;
+				for (uint64_t div = PLL_PLAN_MS67_MIN_DIV; div <= PLL_PLAN_MS67_MAX_DIV && ms_Hz * div <= SI5351_PLL_VCO_MAX_HZ; div += 2)
+					joint_plan_add_vco(pool, ref_Hz, ms_Hz * div, frac_mode);
+			}
+		}
+	}
+
+	std::sort(pool.begin(), pool.end(), joint_plan_frac_higher);
+	pool.erase(std::unique(pool.begin(), pool.end(), joint_plan_frac_same), pool.end());
+}
+
+bool joint_plan(const uint32_t ref_Hz, const t_joint_output *outputs, t_pll_plan &plan, const int frac_mode, t_joint_plan_stats *stats, const t_plan_cost *cost)
+{
+	const t_plan_cost cost_fn = cost ? *cost : plan_cost_default();
+
+	t_joint_plan_stats st;
+	memset(&st, 0, sizeof(st));
+
+	pll_plan_init(plan, ref_Hz, frac_mode);
+
+	unsigned int wanted = 0;
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		if (outputs[clk].freq_Hz > 0)
+			wanted |= 1u << clk;
+
+	if (ref_Hz == 0 || wanted == 0)
+	{
+		if (stats)
+			*stats = st;
+		return false;
+	}
+
+	std::vector <t_pll_frac> pool;
+	joint_plan_pool(pool, ref_Hz, outputs, frac_mode);
+
+	const size_t candidates = pool.size();
+	const size_t words      = (candidates + 63) / 64;
+	st.candidates = (unsigned int)candidates;
+
+	// **********
+	// every output against every candidate
+
+	std::vector <double>   pll_cost(candidates);
+	std::vector <double>   ms_cost(PLL_PLAN_OUTPUTS * candidates);
+	std::vector <uint64_t> reach(PLL_PLAN_OUTPUTS * words, 0);     // output can use the candidate
+
+	t_pll_plan scratch;
+	for (size_t v = 0; v < candidates; v++)
+	{
+		pll_plan_init(scratch, ref_Hz, frac_mode);
+		pll_plan_set_pll(scratch, 0, pool[v]);
+		pll_cost[v] = cost_fn.fn(scratch, 1u << 0, 0, cost_fn.context);
+
+		for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		{
+			if (!(wanted & (1u << clk)))
+				continue;
+
+			const t_joint_output &out = outputs[clk];
+			if (pll_plan_output_from_pll(scratch, clk, 0, out.freq_Hz) == 0)
+				continue;
+			st.evaluations++;
+
+			const double err_uHz = fabs(scratch.clk_err_uHz[clk]);
+			if (err_uHz > std::max(out.tol_ppm * out.freq_Hz, JOINT_PLAN_EXACT_UHZ))
+				continue;
+
+			ms_cost[(clk * candidates) + v] = cost_fn.fn(scratch, 0, 1u << clk, cost_fn.context);
+			reach[(clk * words) + (v / 64)] |= 1ull << (v % 64);
+		}
+	}
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (!(wanted & (1u << clk)))
+			continue;
+		bool any = false;
+		for (size_t w = 0; w < words && !any; w++)
+			any = reach[(clk * words) + w] != 0;
+		if (!any)
+			st.unreachable |= 1u << clk;
+	}
+
+	if (st.unreachable)
+	{
+		if (stats)
+			*stats = st;
+		return false;
+	}
+
+	// **********
+	// the best VCO for every group of outputs .. a group's candidates are its smaller group's plus one output
+
+	std::vector <uint64_t> group_reach(256 * words, 0);
+	double group_cost[256];
+	int    group_vco[256];
+
+	for (unsigned int group = 1; group < 256; group++)
+	{
+		group_cost[group] = -1.0;
+		group_vco[group]  = -1;
+
+		if (group & ~wanted)
+			continue;
+
+		const unsigned int smaller = group & (group - 1);
+		unsigned int       clk     = 0;
+		while (!(group & (1u << clk)))
+			clk++;
+
+		if (smaller && group_vco[smaller] < 0)
+		{	// already ruled out
+			st.pruned++;
+			continue;
+		}
+
+		uint64_t       *dst = &group_reach[group * words];
+		const uint64_t *out = &reach[clk * words];
+		if (smaller)
+		{
+			const uint64_t *src = &group_reach[smaller * words];
+			for (size_t w = 0; w < words; w++)
+				dst[w] = src[w] & out[w];
+		}
+		else
+			memcpy(dst, out, words * sizeof(uint64_t));
+
+		for (size_t w = 0; w < words; w++)
+		{
+			for (uint64_t bits = dst[w]; bits; bits &= bits - 1)
+			{
+				unsigned int bit = 0;
+				while (!(bits & (1ull << bit)))
+					bit++;
+				const size_t v = (w * 64) + bit;
+
+				double sum = pll_cost[v];
+				for (unsigned int k = 0; k < PLL_PLAN_OUTPUTS; k++)
+					if (group & (1u << k))
+						sum += ms_cost[(k * candidates) + v];
+
+				if (group_vco[group] < 0 || group_cost[group] > sum)
+				{
+					group_cost[group] = sum;
+					group_vco[group]  = (int)v;
+				}
+			}
+		}
+
+		if (group_vco[group] < 0)
+			st.pruned++;
+		else
+			st.groups++;
+	}
+
+	// **********
+	// the best split between PLL-A (the group with the lowest output) and PLL-B .. all on PLL-A first so it wins a tie
+
+	const unsigned int lowest = wanted & (0u - wanted);
+
+	unsigned int best_group = 0;
+	double       best_cost  = -1.0;
+
+	for (unsigned int group = wanted; group; group = (group - 1) & wanted)
+	{
+		if (!(group & lowest) || group_vco[group] < 0)
+			continue;
+
+		const unsigned int rest = wanted & ~group;
+		if (rest && group_vco[rest] < 0)
+			continue;
+
+		const double sum = group_cost[group] + (rest ? group_cost[rest] : 0.0);
+		if (best_cost < 0.0 || best_cost > sum)
+		{
+			best_cost  = sum;
+			best_group = group;
+		}
+	}
+
+	if (best_group == 0)
+	{
+		if (stats)
+			*stats = st;
+		return false;
+	}
+
+	st.cost = best_cost;
+
+	// **********
+	// the plan
+
+	const unsigned int groups[2] = {best_group, wanted & ~best_group};
+	for (unsigned int pll = 0; pll < 2; pll++)
+	{
+		if (groups[pll] == 0)
+			continue;
+
+		pll_plan_set_pll(plan, pll, pool[group_vco[groups[pll]]]);
+
+		for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+			if (groups[pll] & (1u << clk))
+				pll_plan_output_from_pll(plan, clk, pll, outputs[clk].freq_Hz);
+	}
+
+	if (stats)
+		*stats = st;
+	return true;
+}
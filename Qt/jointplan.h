@@ -0,0 +1,40 @@
+// Si5351 I2C data decoder
+//
+// Joint multi-output frequency planner .. up to 8 outputs, each with a tolerance, shared out between PLL-A and PLL-B
+//
+// every output is scored against a pool of candidate VCO frequencies (the integer PLL ones plus the ones that give
+// each output an even integer multisynth), then every split of the outputs into two PLL groups is tried .. a group
+// can only use the VCO frequencies all its outputs can reach, so a group no VCO satisfies rules out all its supersets
+
+#ifndef JOINTPLAN_H
+#define JOINTPLAN_H
+
+#include <stdint.h>
+
+#include "pllplan.h"
+#include "plancost.h"
+
+// errors below this count as exact whatever the tolerance (micro Hz)
+#define JOINT_PLAN_EXACT_UHZ        1.0
+
+struct t_joint_output
+{
+	uint32_t freq_Hz;       // 0 = output not used
+	double   tol_ppm;       // allowed error
+};
+
+struct t_joint_plan_stats
+{
+	unsigned int candidates;    // VCO frequencies in the pool
+	unsigned int evaluations;   // output/VCO pairs planned
+	unsigned int groups;        // output groups with at least one VCO frequency
+	unsigned int pruned;        // output groups ruled out
+	uint8_t      unreachable;   // bit mask of the outputs no VCO frequency reaches
+	double       cost;          // of the chosen plan
+};
+
+// plan all the used outputs at once (outputs[0] to outputs[7] = CLK-0 to CLK-7), the plan is only valid if it returns true,
+// the plans are ranked by 'cost' (nullptr = plan_cost_default())
+bool joint_plan(const uint32_t ref_Hz, const t_joint_output *outputs, t_pll_plan &plan, const int frac_mode = PLL_FRAC_DENOM, t_joint_plan_stats *stats = nullptr, const t_plan_cost *cost = nullptr);
+
+#endif
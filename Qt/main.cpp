@@ -1,12 +1,16 @@
-#include "mainwindow.h"
-
-#include <QApplication>
-
-int main(int argc, char *argv[])
-{
-	QApplication a(argc, argv);
-	a.setApplicationVersion("1.0.6.0");
-	MainWindow w;
-	w.show();
-	return a.exec();
-}
+#include "mainwindow.h"
+#include "cli.h"
+
+#include <QApplication>
+
+int main(int argc, char *argv[])
+{
+	if (cli_command(argc, argv))
+		return cli_main(argc, argv);
+
+	QApplication a(argc, argv);
+	a.setApplicationVersion("1.0.6.0");
+	MainWindow w;
+	w.show();
+	return a.exec();
+}
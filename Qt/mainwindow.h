@@ -1,98 +1,214 @@
-
-// Si5351 I2C data decoder
-//
-// Written by Cathy G6AMU
-// August 2021
-
-#ifndef MAINWINDOW_H
-#define MAINWINDOW_H
-
-#include <QMainWindow>
-#include <QMutex>
-
-#include <vector>
-#include <stdint.h>
-
-QT_BEGIN_NAMESPACE
-    namespace Ui { class MainWindow; }
-QT_END_NAMESPACE
-
-struct TVersion
-{
-	uint16_t MajorVer;
-	uint16_t MinorVer;
-	uint16_t ReleaseVer;
-	uint16_t BuildVer;
-	TVersion() : MajorVer(0), MinorVer(0), ReleaseVer(0), BuildVer(0) {}
-};
-
-class MainWindow : public QMainWindow
-{
-	Q_OBJECT
-
-public:
-	MainWindow(QWidget *parent = nullptr);
-	~MainWindow();
-
-private slots:
-	void on_FileOpenPushButton_clicked();
-
-	void on_RefHzLineEdit_textChanged(const QString &arg1);
-
-	void on_FileListView_clicked(const QModelIndex &index);
-
-	void onTableWidgetCellSelected(int nRow, int nCol);
-
-	void onSelectionChanged();
-
-	void on_splitter_splitterMoved(int pos, int index);
-
-	void on_testPushButton_clicked();
-
-	protected:
-	void showEvent(QShowEvent *event);
-	void resizeEvent(QResizeEvent *event);
-
-private:
-	Ui::MainWindow *ui;
-
-	bool m_shown;
-
-	QString m_title_string;
-
-	QString m_ini_filename;
-
-	QString                               m_filename;
-	std::vector <uint8_t>                 m_file_data;
-	std::vector < std::vector <QString> > m_parsed_file_lines;
-	std::vector < std::vector <uint8_t> > m_file_line_reg_values;
-
-	int m_file_line_clicked;
-
-	double m_xtal_Hz;
-
-	uint8_t m_si5351_reg_values[256];
-
-	QMutex m_file_mutex;
-
-	void __fastcall sizeRegisterColoumns();
-
-	void __fastcall selectFile();
-
-	void __fastcall loadSettings();
-	void __fastcall saveSettings();
-
-	bool __fastcall loadFile(QString filename);
-
-	bool __fastcall processData(std::vector < std::vector <QString> > &parsed_file_lines);
-
-	void __fastcall resetSi5351RegValues();
-
-	QString __fastcall regSettingDescription(const int addr, const uint8_t value);
-
-	void __fastcall updateFrequencies();
-
-	void __fastcall updateRegisterListView(const bool show_updated);
-};
-
-#endif
+
+// Si5351 I2C data decoder
+//
+// Written by Cathy G6AMU
+// August 2021
+
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <QMutex>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSplitter>
+
+#include <vector>
+#include <stdint.h>
+
+#include "si5351.h"
+#include "regdesc.h"
+#include "registertablemodel.h"
+#include "capture.h"
+#include "capturelistmodel.h"
+#include "stateworker.h"
+#include "timeline.h"
+#include "freqplotwidget.h"
+#include "heatmap.h"
+#include "heatmapwidget.h"
+#include "regindex.h"
+#include "events.h"
+#include "diffwindow.h"
+#include "statehash.h"
+#include "statecatalog.h"
+#include "catalogwindow.h"
+#include "redundant.h"
+#include "redundantwindow.h"
+#include "writeseqwindow.h"
+#include "bustimewindow.h"
+
+#define RENDER_FRAME_MS     16	// minimum time between register display updates while scrolling through the lines
+
+QT_BEGIN_NAMESPACE
+    namespace Ui { class MainWindow; }
+QT_END_NAMESPACE
+
+struct TVersion
+{
+	uint16_t MajorVer;
+	uint16_t MinorVer;
+	uint16_t ReleaseVer;
+	uint16_t BuildVer;
+	TVersion() : MajorVer(0), MinorVer(0), ReleaseVer(0), BuildVer(0) {}
+};
+
+class MainWindow : public QMainWindow
+{
+	Q_OBJECT
+
+public:
+	MainWindow(QWidget *parent = nullptr);
+	~MainWindow();
+
+private slots:
+	void on_FileOpenPushButton_clicked();
+
+	void on_RefHzLineEdit_textChanged(const QString &arg1);
+
+	void on_FileListView_clicked(const QModelIndex &index);
+
+	void onRegisterTableDoubleClicked(const QModelIndex &index);
+
+	void onRegisterTableContextMenu(const QPoint &pos);
+
+	void onNextEvent();
+
+	void onPrevEvent();
+
+	void onEventFilterChanged();
+
+	void onCompareCapture();
+
+	void onNextSameState();
+
+	void onPrevSameState();
+
+	void onShowStateCatalog();
+
+	void onShowRedundantWrites();
+
+	void onShowWriteSequence();
+
+	void onShowBusTime();
+
+	void onSelectionChanged();
+
+	void onRegisterStateReady();
+
+	void onRenderTimer();
+
+	void onSeekLine(int line);
+
+	void on_splitter_splitterMoved(int pos, int index);
+
+	void on_testPushButton_clicked();
+
+	protected:
+	void showEvent(QShowEvent *event);
+	void resizeEvent(QResizeEvent *event);
+
+private:
+	Ui::MainWindow *ui;
+
+	bool m_shown;
+
+	QString m_title_string;
+
+	QString m_ini_filename;
+
+	bool m_warm_desc_cache;
+	RegDescriptionWarmThread *m_desc_warm_thread;
+
+	QString                               m_filename;
+	t_capture                             m_capture;
+	CaptureListModel                     *m_capture_model;
+
+	RegisterStateWorker *m_state_worker;
+	QTimer              *m_render_timer;
+	QElapsedTimer        m_render_elapsed;
+
+	// per line PLL/CLK frequencies of the whole capture, plotted under the register table
+	t_freq_timeline  m_timeline;
+	FreqPlotWidget  *m_freq_plot;
+	QSplitter       *m_plot_splitter;
+
+	// register write density of the whole capture
+	t_write_heatmap  m_write_heatmap;
+	HeatmapWidget   *m_heatmap_widget;
+
+	// the lines that wrote each register
+	t_reg_index      m_reg_index;
+
+	// frequency/output enable/PLL reset points of the capture, and the types the navigation stops at
+	t_event_index    m_events;
+	uint32_t         m_event_mask;
+	QAction         *m_event_freq_action;
+	QAction         *m_event_oe_action;
+	QAction         *m_event_reset_action;
+
+	// register image hash after each line
+	t_state_hashes   m_state_hashes;
+
+	// the distinct register states of the capture
+	t_state_catalog     m_state_catalog;
+	StateCatalogWindow *m_catalog_window;
+
+	// written bytes that didn't change the register image
+	t_redundant_writes     m_redundant_writes;
+	RedundantWritesWindow *m_redundant_window;
+
+	// minimal writes from one line's register state to another's
+	WriteSequenceWindow *m_writeseq_window;
+
+	// per line bus time and retune latency
+	BusTimeWindow *m_bustime_window;
+
+	// capture to capture diff against this capture
+	CaptureDiffWindow *m_diff_window;
+
+	int m_file_line_clicked;
+
+	double m_xtal_Hz;
+
+	uint8_t m_si5351_reg_values[256];
+
+	RegisterTableModel *m_register_model;
+
+	// the register image the frequency display was last evaluated from
+	uint8_t        m_shown_reg_values[256];
+	t_si5351_freqs m_freqs;
+	uint32_t       m_freqs_dirty;
+
+	QMutex m_file_mutex;
+
+	void __fastcall sizeRegisterColoumns();
+
+	void __fastcall selectFile();
+
+	void __fastcall loadSettings();
+	void __fastcall saveSettings();
+
+	bool __fastcall readCaptureFile(QString filename, t_capture &capture);
+
+	void __fastcall detachCapture();
+
+	bool __fastcall loadFile(QString filename);
+
+	bool __fastcall processData();
+
+	void __fastcall resetSi5351RegValues();
+
+	void __fastcall updateFrequencies(const uint32_t dirty);
+
+	void __fastcall updateRegisterListView(const bool show_updated);
+
+	void __fastcall showRegisterValues(bool *updated_regs, const bool show_updated);
+
+	void __fastcall scheduleRegisterListView();
+
+	void __fastcall seekEvent(const bool forward);
+
+	void __fastcall seekSameState(const bool forward);
+};
+
+#endif
@@ -0,0 +1,153 @@
+// Si5351 I2C data decoder
+//
+// Bounded thread safe cache of planned sweep points
+
+#include "plancache.h"
+
+// ****************************************************************
+
+bool t_plan_cache_key::operator == (const t_plan_cache_key &key) const
+{
+	return ref_Hz               == key.ref_Hz &&
+	       freq_Hz              == key.freq_Hz &&
+	       clk                  == key.clk &&
+	       pll                  == key.pll &&
+	       frac_mode            == key.frac_mode &&
+	       fixed_pll            == key.fixed_pll &&
+	       fixed_pll_frac.a     == key.fixed_pll_frac.a &&
+	       fixed_pll_frac.b     == key.fixed_pll_frac.b &&
+	       fixed_pll_frac.c     == key.fixed_pll_frac.c &&
+	       cost_fn              == key.cost_fn &&
+	       cost_context         == key.cost_context;
+}
+
+static uint64_t plan_cache_mix(uint64_t h, const uint64_t v)
+{	// 64-bit FNV-1a style step followed by a multiply-xorshift so similar frequencies spread across the shards
+	h ^= v;
+	h *= 0x100000001b3ull;
+	h ^= h >> 29;
+	return h;
+}
+
+size_t t_plan_cache_hash::operator () (const t_plan_cache_key &key) const
+{
+	uint64_t h = 0xcbf29ce484222325ull;
+	h = plan_cache_mix(h, ((uint64_t)key.ref_Hz << 32) | key.freq_Hz);
+	h = plan_cache_mix(h, ((uint64_t)key.clk << 24) | ((uint64_t)key.pll << 16) | ((uint64_t)key.frac_mode << 8) | key.fixed_pll);
+	if (key.fixed_pll)
+	{
+		h = plan_cache_mix(h, ((uint64_t)key.fixed_pll_frac.a << 32) | key.fixed_pll_frac.b);
+		h = plan_cache_mix(h, key.fixed_pll_frac.c);
+	}
+	h = plan_cache_mix(h, (uint64_t)(uintptr_t)key.cost_context);
+	return (size_t)h;
+}
+
+t_plan_cache_key plan_cache_key(const t_sweep_params &params, const uint32_t freq_Hz)
+{
+	t_plan_cache_key key;
+	key.ref_Hz       = params.ref_Hz;
+	key.freq_Hz      = freq_Hz;
+	key.clk          = (uint8_t)params.clk;
+	key.pll          = (uint8_t)params.pll;
+	key.frac_mode    = (uint8_t)params.frac_mode;
+	key.fixed_pll    = params.fixed_pll ? 1 : 0;
+	key.cost_fn      = (params.cost && !params.fixed_pll) ? params.cost->fn      : nullptr;
+	key.cost_context = (params.cost && !params.fixed_pll) ? params.cost->context : nullptr;
+
+	if (params.fixed_pll)
+		key.fixed_pll_frac = params.fixed_pll_frac;
+	else
+	{
+		key.fixed_pll_frac.a = 0;
+		key.fixed_pll_frac.b = 0;
+		key.fixed_pll_frac.c = 1;
+	}
+
+	return key;
+}
+
+// ****************************************************************
+
+t_plan_cache::t_plan_cache(const size_t entries) :
+	m_shard_entries((entries + PLAN_CACHE_SHARDS - 1) / PLAN_CACHE_SHARDS),
+	m_hits(0),
+	m_misses(0),
+	m_evictions(0)
+{
+	if (m_shard_entries == 0)
+		m_shard_entries = 1;
+}
+
+t_plan_cache::t_shard &t_plan_cache::shard(const t_plan_cache_key &key, size_t &hash)
+{
+	hash = t_plan_cache_hash()(key);
+	return m_shards[(hash >> 7) % PLAN_CACHE_SHARDS];	// not the low bits, the shard's own map uses those
+}
+
+bool t_plan_cache::find(const t_plan_cache_key &key, t_sweep_point &point)
+{
+	size_t   hash;
+	t_shard &s = shard(key, hash);
+
+	std::lock_guard <std::mutex> lock(s.mutex);
+
+	const auto it = s.index.find(key);
+	if (it == s.index.end())
+	{
+		m_misses++;
+		return false;
+	}
+
+	// now the most recently used
+	s.lru.splice(s.lru.begin(), s.lru, it->second);
+
+	point = it->second->second;
+	m_hits++;
+	return true;
+}
+
+void t_plan_cache::insert(const t_plan_cache_key &key, const t_sweep_point &point)
+{
+	size_t   hash;
+	t_shard &s = shard(key, hash);
+
+	std::lock_guard <std::mutex> lock(s.mutex);
+
+	const auto it = s.index.find(key);
+	if (it != s.index.end())
+	{	// another thread got there first
+		it->second->second = point;
+		s.lru.splice(s.lru.begin(), s.lru, it->second);
+		return;
+	}
+
+	if (s.index.size() >= m_shard_entries)
+	{	// drop the least recently used
+		s.index.erase(s.lru.back().first);
+		s.lru.pop_back();
+		m_evictions++;
+	}
+
+	s.lru.push_front(std::make_pair(key, point));
+	s.index[key] = s.lru.begin();
+}
+
+void t_plan_cache::clear()
+{
+	for (unsigned int i = 0; i < PLAN_CACHE_SHARDS; i++)
+	{
+		std::lock_guard <std::mutex> lock(m_shards[i].mutex);
+		m_shards[i].index.clear();
+		m_shards[i].lru.clear();
+	}
+
+	m_hits      = 0;
+	m_misses    = 0;
+	m_evictions = 0;
+}
+
+size_t t_plan_cache::entries() const
+{
+	return m_shard_entries * PLAN_CACHE_SHARDS;
+}
@@ -0,0 +1,85 @@
+// Si5351 I2C data decoder
+//
+// Bounded thread safe cache of planned sweep points, in front of the planner
+//
+// keyed by the reference, the requested frequency, the output/PLL and everything that changes how the planner plans
+// (fraction mode, fixed PLL, cost function) .. the least recently used entries go when it's full, split into shards
+// each with its own lock so the sweep threads rarely wait on each other
+
+#ifndef PLANCACHE_H
+#define PLANCACHE_H
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <stdint.h>
+
+#include "sweep.h"
+
+#define PLAN_CACHE_SHARDS           16
+#define PLAN_CACHE_DEFAULT_ENTRIES  65536
+
+struct t_plan_cache_key
+{
+	uint32_t       ref_Hz;
+	uint32_t       freq_Hz;
+	uint8_t        clk;
+	uint8_t        pll;
+	uint8_t        frac_mode;
+	uint8_t        fixed_pll;
+	t_pll_frac     fixed_pll_frac;      // only if fixed_pll
+	t_plan_cost_fn cost_fn;             // nullptr = the planner's own choice
+	const void     *cost_context;       // by address .. clear the cache if the weights behind it change
+
+	bool operator == (const t_plan_cache_key &key) const;
+};
+
+struct t_plan_cache_hash
+{
+	size_t operator () (const t_plan_cache_key &key) const;
+};
+
+// the key of a sweep point
+t_plan_cache_key plan_cache_key(const t_sweep_params &params, const uint32_t freq_Hz);
+
+class t_plan_cache
+{
+public:
+	t_plan_cache(const size_t entries = PLAN_CACHE_DEFAULT_ENTRIES);
+
+	// true and the point if it's cached
+	bool find(const t_plan_cache_key &key, t_sweep_point &point);
+
+	// add (or refresh) a point, dropping the least recently used one of its shard if that's full
+	void insert(const t_plan_cache_key &key, const t_sweep_point &point);
+
+	void clear();
+
+	size_t entries() const;     // the bound
+
+	uint64_t hits() const      { return m_hits; }
+	uint64_t misses() const    { return m_misses; }
+	uint64_t evictions() const { return m_evictions; }
+
+private:
+	typedef std::list <std::pair <t_plan_cache_key, t_sweep_point> > t_lru;
+
+	struct t_shard
+	{
+		std::mutex mutex;
+		t_lru      lru;     // most recently used first
+		std::unordered_map <t_plan_cache_key, t_lru::iterator, t_plan_cache_hash> index;
+	};
+
+	t_shard &shard(const t_plan_cache_key &key, size_t &hash);
+
+	t_shard m_shards[PLAN_CACHE_SHARDS];
+	size_t  m_shard_entries;
+
+	std::atomic <uint64_t> m_hits;
+	std::atomic <uint64_t> m_misses;
+	std::atomic <uint64_t> m_evictions;
+};
+
+#endif
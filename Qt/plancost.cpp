@@ -0,0 +1,108 @@
+// Si5351 I2C data decoder
+//
+// Plan cost model
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "si5351.h"
+#include "plancost.h"
+
+// ****************************************************************
+
+const t_plan_cost_weights plan_cost_default_weights =
+{
+	3.0,        // pll_fractional
+	1.0,        // pll_odd
+	0.5,        // pll_vco_low
+	3.0,        // ms_fractional
+	1.0,        // ms_odd
+	0.0,        // ms_div_by_4
+	0.1,        // r_div
+	1e-3        // err_ppm
+};
+
+double plan_cost_jitter(const t_pll_plan &plan, const unsigned int plls, const unsigned int clks, const void *context)
+{
+	const t_plan_cost_weights &w = context ? *(const t_plan_cost_weights *)context : plan_cost_default_weights;
+
+	double cost = 0.0;
+
+	for (unsigned int pll = 0; pll < 2; pll++)
+	{
+		if (!(plls & (1u << pll)))
+			continue;
+
+		const t_pll_frac &f = plan.pll[pll];
+		if (f.b > 0)
+			cost += w.pll_fractional;
+		else
+		if (f.a & 1)
+			cost += w.pll_odd;
+
+		const double vco_Hz = plan.pll_Hz[pll];
+		if (vco_Hz < SI5351_PLL_VCO_MAX_HZ)
+			cost += w.pll_vco_low * (SI5351_PLL_VCO_MAX_HZ - vco_Hz) / (SI5351_PLL_VCO_MAX_HZ - SI5351_PLL_VCO_MIN_HZ);
+	}
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (!(clks & (1u << clk)))
+			continue;
+
+		const t_pll_plan_ms &ms = plan.ms[clk];
+		if (clk < 6)
+		{	// multisynth 6/7 are always even integer
+			if (ms.div_by_4 == 3)
+				cost += w.ms_div_by_4;
+			else
+			if (ms.div.b > 0)
+				cost += w.ms_fractional;
+			else
+			if (ms.div.a & 1)
+				cost += w.ms_odd;
+		}
+
+		cost += w.r_div * ms.r_div;
+
+		if (ms.want_Hz > 0)
+			cost += w.err_ppm * fabs(plan.clk_err_uHz[clk]) / ms.want_Hz;
+	}
+
+	return cost;
+}
+
+t_plan_cost plan_cost_default()
+{
+	t_plan_cost cost;
+	cost.fn      = plan_cost_jitter;
+	cost.context = nullptr;
+	return cost;
+}
+
+bool plan_cost_parse_weights(const char *s, t_plan_cost_weights &weights)
+{
+	double *w[PLAN_COST_WEIGHTS] =
+	{
+		&weights.pll_fractional,
+		&weights.pll_odd,
+		&weights.pll_vco_low,
+		&weights.ms_fractional,
+		&weights.ms_odd,
+		&weights.ms_div_by_4,
+		&weights.r_div,
+		&weights.err_ppm
+	};
+
+	for (unsigned int i = 0; i < PLAN_COST_WEIGHTS && *s; i++)
+	{
+		char *end = nullptr;
+		const double v = strtod(s, &end);
+		if (end == s || (*end != ',' && *end != '\0') || v < 0.0)
+			return false;
+		*w[i] = v;
+		s = (*end == ',') ? end + 1 : end;
+	}
+
+	return *s == '\0';
+}
@@ -0,0 +1,49 @@
+// Si5351 I2C data decoder
+//
+// Plan cost model .. scores a plan's outputs for phase noise/jitter so the planners can rank their candidate plans
+//
+// a cost function has to be a sum of per PLL and per output terms (the joint planner scores PLLs and outputs
+// separately then adds them up), lower is better
+
+#ifndef PLANCOST_H
+#define PLANCOST_H
+
+#include "pllplan.h"
+
+// score the PLLs in the 'plls' bit mask and the outputs in the 'clks' bit mask of a plan
+typedef double (*t_plan_cost_fn)(const t_pll_plan &plan, const unsigned int plls, const unsigned int clks, const void *context);
+
+struct t_plan_cost
+{
+	t_plan_cost_fn fn;
+	const void     *context;    // passed to fn
+};
+
+// weights of the default cost function
+struct t_plan_cost_weights
+{
+	double pll_fractional;      // per PLL not integer
+	double pll_odd;             // per PLL integer but odd (no integer mode)
+	double pll_vco_low;         // per PLL, scaled 0 (VCO at its max) to 1 (VCO at its min)
+	double ms_fractional;       // per output multisynth not integer
+	double ms_odd;              // per output multisynth integer but odd (no integer mode)
+	double ms_div_by_4;         // per output in divide by 4 mode
+	double r_div;               // per output R-divider step (/2 = 1, /4 = 2 ..)
+	double err_ppm;             // per ppm of output frequency error
+};
+
+#define PLAN_COST_WEIGHTS   8
+
+// integer beats fractional, even beats odd, a higher VCO and less error break ties
+extern const t_plan_cost_weights plan_cost_default_weights;
+
+// the default cost function, 'context' is a t_plan_cost_weights (nullptr = the default weights)
+double plan_cost_jitter(const t_pll_plan &plan, const unsigned int plls, const unsigned int clks, const void *context);
+
+// plan_cost_jitter() with the default weights
+t_plan_cost plan_cost_default();
+
+// weights from a comma separated list in t_plan_cost_weights order, missing ones left as they are, false if one's bad
+bool plan_cost_parse_weights(const char *s, t_plan_cost_weights &weights);
+
+#endif
@@ -0,0 +1,28 @@
+// Si5351 I2C data decoder
+//
+// Si5351 frequency planner .. the planning math is constexpr in pllplan.h, this is the run time only part
+
+#include "si5351.h"
+#include "pllplan.h"
+
+// ****************************************************************
+
+// build time checks of the constexpr planning math
+static_assert(pll_find_VCO_freq(25000000, 10000000) == 900000000, "pll_find_VCO_freq");
+static_assert(pll_plan_valid(pll_plan_fixed(SI5351_XTAL_HZ, {27000000, 48000000, 12288000}, {0, 0, 1})), "pll_plan_fixed");
+// outputs the Si5351 can't do are left out, not clamped into an invalid plan
+static_assert(pll_plan_fixed(25000000, {0, 0, 0, 0, 0, 0, 200000000}, {0, 0, 0, 0, 0, 0, 0}).used_clks == 0, "pll_plan_fixed MS6 too high");
+static_assert(pll_plan_fixed(25000000, {0, 0, 0, 0, 0, 0, 2500}, {0, 0, 0, 0, 0, 0, 0}).used_clks == 0, "pll_plan_fixed MS6 too low");
+static_assert(pll_plan_fixed(25000000, {130000000}, {0}).used_clks == 0, "pll_plan_fixed MS0 VCO too low");
+static_assert(pll_plan_fixed(25000000, {27000000, 0, 0, 0, 0, 0, 0, 2500}, {0, 0, 0, 0, 0, 0, 0, 0}).used_clks == 0x01, "pll_plan_fixed MS7 from the PLL");
+static_assert(pll_plan_blob(pll_plan_fixed(SI5351_XTAL_HZ, {10000000}, {0})).size == 1 + (SI5351_REG_MS0_PARAMETERS + 7) - SI5351_REG_PLL_INPUT_SOURCE + 1, "pll_plan_blob");
+
+// ****************************************************************
+
+void pll_plan_init(t_pll_plan &plan, const uint32_t ref_Hz, const int frac_mode)
+{
+	uint8_t reset_regs[256];
+	si5351_reset_regs(reset_regs);
+
+	pll_plan_start(plan, ref_Hz, frac_mode, reset_regs);
+}
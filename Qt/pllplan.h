@@ -0,0 +1,872 @@
+// Si5351 I2C data decoder
+//
+// Si5351 frequency planner .. PLL/multisynth parameters and register values for the CLK outputs
+//
+// everything a plan needs is in the plan object, so plans can be computed concurrently
+//
+// the planning math is all constexpr (C++14) so fixed frequency plans and their register bursts can be made at compile
+// time, pll_plan_fixed() and pll_plan_blob() below .. only pll_plan_init() (the full reset register image) is run time
+
+#ifndef PLLPLAN_H
+#define PLLPLAN_H
+
+#include <stdint.h>
+
+#include "si5351.h"
+
+#define PLL_PLAN_OUTPUTS            8
+
+// multisynth 6 and 7 are even integer dividers only
+#define PLL_PLAN_MS67_MIN_DIV       6
+#define PLL_PLAN_MS67_MAX_DIV       254
+
+// start register address byte followed by registers 15 (PLL input source) to 92 (MS6/7 output dividers)
+#define PLL_PLAN_BUFFER_SIZE        (1 + (92 - 15) + 1)
+
+// how the fractional b/c parts are chosen
+#define PLL_FRAC_DENOM              0   // over the (2^20 - 1) denominator then reduced (the original method)
+#define PLL_FRAC_BEST               1   // best rational approximation with c < 2^20 (continued fractions), the least frequency error
+
+#define PLL_FRAC_MAX_C              ((1u << 20) - 1)
+
+// a + (b / c)
+struct t_pll_frac
+{
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+};
+
+struct t_pll_plan_ms
+{
+	t_pll_frac div;
+	uint8_t    r_div;       // output R-divider, divides by 1 << r_div
+	uint8_t    div_by_4;    // 3 = fixed divide by 4 mode
+	uint8_t    pll;         // 0 = PLL-A, 1 = PLL-B
+	uint32_t   want_Hz;     // the frequency asked for
+};
+
+struct t_pll_plan
+{
+	uint32_t ref_Hz;
+
+	int frac_mode;          // PLL_FRAC_xxx
+
+	uint32_t   pll_Hz[2];
+	t_pll_frac pll[2];
+
+	uint32_t      clk_Hz[PLL_PLAN_OUTPUTS];   // achieved output frequency
+	double        clk_err_uHz[PLL_PLAN_OUTPUTS];  // exact achieved minus asked for output frequency (micro Hz)
+	t_pll_plan_ms ms[PLL_PLAN_OUTPUTS];
+
+	uint8_t used_plls;      // bit mask
+	uint8_t used_clks;      //   "
+
+	uint8_t regs[256];      // register image .. the reset state with the planned outputs on top
+};
+
+// a plan's I2C burst
+struct t_pll_plan_blob
+{
+	uint8_t      data[PLL_PLAN_BUFFER_SIZE];
+	unsigned int size;
+};
+
+// ****************************************************************
+
+constexpr long double pll_fabsl(const long double v)
+{	// fabsl() isn't constexpr
+	return (v < 0) ? -v : v;
+}
+
+constexpr uint32_t pll_gcd(uint32_t b, uint32_t c)
+{	// compute the GCD (Greatest Common Divisor)
+	while (c)
+	{
+		b %= c;
+		if (!b)
+			return c;
+		c %= b;
+	}
+	return b;
+}
+
+// try to find an even integer PLL VCO frequency for an output (multisynth 0 to 5), 0 if there isn't one
+constexpr uint32_t pll_find_VCO_freq(const uint32_t ref_Hz, const uint32_t ms_Hz)
+{	// try to find an even integer PLL VCO frequency - this would produce the minimum level of output jitter
+
+	const uint32_t vco_lo = SI5351_PLL_VCO_MIN_HZ;
+	const uint32_t vco_hi = SI5351_PLL_VCO_MAX_HZ;
+
+	if (ref_Hz == 0 || ms_Hz == 0)
+		return 0;
+
+	// the VCO has to be a multiple of ref_Hz (integer PLL) and an even multiple of ms_Hz (even integer MS divider),
+	// so it's a multiple of lcm(ref_Hz, 2 * ms_Hz) .. rather than stepping through every multiple of ref_Hz in the
+	// VCO range, start at the highest multiple of the lcm and only step down past the dividers the MS can't do (6)
+
+	const uint64_t ms2  = 2 * (uint64_t)ms_Hz;
+	const uint64_t step = (ref_Hz / pll_gcd(ref_Hz, (uint32_t)(ms2 % ref_Hz))) * ms2;	// lcm
+	if (step > vco_hi)
+		return 0;
+
+	// the highest PLL VCO frequency that uses an even integer fout divider ratio
+	uint64_t vco = (vco_hi / step) * step;
+	while (vco >= vco_lo)
+	{
+		const uint64_t a = vco / ms_Hz;
+		if (a == 4 || a >= 8)
+			return (uint32_t)vco;
+		if (a < 4 || vco < vco_lo + step)
+			break;
+		vco -= step;
+	}
+
+	return 0;
+}
+
+// the same for multisynth 6/7 .. even integer dividers 6 to 254 only, preferring an integer PLL, 0 if none fit the VCO range
+constexpr uint32_t pll_find_VCO_freq_ms67(const uint32_t ref_Hz, const uint32_t ms_Hz)
+{
+	uint32_t highest_Hz = 0;
+
+	if (ref_Hz == 0 || ms_Hz == 0)
+		return 0;
+
+	for (uint32_t a = PLL_PLAN_MS67_MAX_DIV; a >= PLL_PLAN_MS67_MIN_DIV; a -= 2)
+	{
+		const uint64_t vco = (uint64_t)ms_Hz * a;
+		if (vco > SI5351_PLL_VCO_MAX_HZ)
+			continue;
+		if (vco < SI5351_PLL_VCO_MIN_HZ)
+			break;
+		if ((vco % ref_Hz) == 0)
+			return (uint32_t)vco;	// integer PLL too
+		if (highest_Hz == 0)
+			highest_Hz = (uint32_t)vco;
+	}
+
+	return highest_Hz;
+}
+
+// the best rational approximations of p/q (p < q) with a denominator up to max_c .. the last continued fraction
+// convergent and the best semiconvergent past it (they're either side of p/q), returns how many (1 or 2)
+constexpr unsigned int pll_best_fracs(uint64_t p, uint64_t q, const uint32_t max_c, uint32_t *b, uint32_t *c)
+{
+	if (p == 0 || q == 0)
+	{
+		b[0] = 0;
+		c[0] = 1;
+		return 1;
+	}
+
+	// convergents h/k of the continued fraction of p/q
+	uint64_t h0 = 0;
+	uint64_t k0 = 1;
+	uint64_t h1 = 1;
+	uint64_t k1 = 0;
+
+	while (q)
+	{
+		const uint64_t a = p / q;
+
+		if (k1 > 0 && a > (max_c - k0) / k1)
+		{	// the next convergent's denominator is too big .. the largest semiconvergent that fits is the best on the other side
+			b[0] = (uint32_t)h1;
+			c[0] = (uint32_t)k1;
+
+			const uint64_t t = (max_c - k0) / k1;
+			if (t == 0)
+				return 1;
+
+			b[1] = (uint32_t)((t * h1) + h0);
+			c[1] = (uint32_t)((t * k1) + k0);
+			return 2;
+		}
+
+		const uint64_t h2 = (a * h1) + h0;
+		const uint64_t k2 = (a * k1) + k0;
+		h0 = h1;
+		k0 = k1;
+		h1 = h2;
+		k1 = k2;
+
+		const uint64_t r = p - (a * q);
+		p = q;
+		q = r;
+	}
+
+	// exact
+	b[0] = (uint32_t)h1;
+	c[0] = (uint32_t)k1;
+	return 1;
+}
+
+// the 8 P1/P2/P3 parameter registers of a PLL or multisynth 0 to 5
+constexpr void pll_set_params(uint8_t *p, uint32_t a, uint32_t b, uint32_t c, const uint8_t r_div, const uint8_t div_by_4)
+{
+	a <<= 7;
+	b <<= 7;
+	const uint32_t f  = b / c;
+	const uint32_t p1 = a +  f - 512;
+	const uint32_t p2 = b - (f * c);
+	const uint32_t p3 = c;
+
+	*p++ =  (p3 >>  8) & 0xff;
+	*p++ =  (p3 >>  0) & 0xff;
+	*p++ = ((p1 >> 16) & 0x03) | ((r_div & 0x07) << 4) | ((div_by_4 & 0x03) << 2);
+	*p++ =  (p1 >>  8) & 0xff;
+	*p++ =  (p1 >>  0) & 0xff;
+	*p++ = ((p3 >> 12) & 0xf0) | ((p2 >> 16) & 0x0f);
+	*p++ =  (p2 >>  8) & 0xff;
+	*p++ =  (p2 >>  0) & 0xff;
+}
+
+// PLL a/b/c for a VCO frequency, returns the achieved VCO frequency
+constexpr uint32_t pll_calc_pll(const uint32_t ref_Hz, uint32_t pll_Hz, uint32_t *pll_a, uint32_t *pll_b, uint32_t *pll_c, const int frac_mode = PLL_FRAC_DENOM)
+{
+	// compute the PLL register values
+	// ref_Hz * (a + (b / c)) = pll_Hz
+
+	uint32_t a = 0;
+	uint32_t b = 0;
+	uint32_t c = 1;
+
+	*pll_a = a;
+	*pll_b = b;
+	*pll_c = c;
+
+	if (ref_Hz == 0 || pll_Hz == 0)
+		return 0;
+
+	a = pll_Hz / ref_Hz;     // integer part
+	b = pll_Hz % ref_Hz;     // fractional part
+	c = ref_Hz;              //    "         "
+
+	if (a < 15)
+	{
+		a = 15;
+		b = 0;
+		c = 1;
+	}
+	else
+	if (a > 90)
+	{
+		a = 90;
+		b = 0;
+		c = 1;
+	}
+	else
+	if (frac_mode == PLL_FRAC_BEST)
+	{	// the b/c nearest to the wanted fraction
+		uint32_t bs[2] = {0, 0};
+		uint32_t cs[2] = {1, 1};
+		const unsigned int n = pll_best_fracs(b, c, PLL_FRAC_MAX_C, bs, cs);
+
+		long double best_err = -1.0;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			const long double err = pll_fabsl(((long double)bs[i] * ref_Hz) - ((long double)b * cs[i])) / cs[i];
+			if (best_err < 0.0 || best_err > err)
+			{
+				best_err = err;
+				b = bs[i];
+				c = cs[i];
+			}
+		}
+
+		if (b >= c)
+		{	// rounded up to the next integer
+			a += b / c;
+			b  = 0;
+			c  = 1;
+		}
+	}
+	else
+	{	// optimise the fractional register values
+		if (b && c)
+		{
+			const uint32_t gcd = pll_gcd(b, c);
+			if (gcd > 1)
+			{
+				b /= gcd;
+				c /= gcd;
+			}
+		}
+
+		if (c >= (1u << 20))
+		{	// the denominator is only 20 bits
+			const uint32_t denom = (1u << 20) - 1;
+			b = (uint32_t)(((uint64_t)b * denom) / c);
+			c = denom;
+		}
+
+		if (b == 0 || c == 0)
+		{
+			b = 0;
+			c = 1;
+		}
+	}
+
+	// recompute the final PLL VCO frequency
+	// pll_Hz = ref_Hz * (a + (b / c))
+	pll_Hz = (ref_Hz * a) + (((uint64_t)ref_Hz * b) / c);
+
+	*pll_a = a;
+	*pll_b = b;
+	*pll_c = c;
+
+	return pll_Hz;
+}
+
+// the VCO frequency is vco_num / vco_den .. it's only used as an exact fraction in the best approximation mode
+constexpr uint32_t pll_calc_ms_frac(const uint64_t vco_num, const uint64_t vco_den, uint32_t ms_Hz, uint32_t *ms_a, uint32_t *ms_b, uint32_t *ms_c, uint8_t *ms_r_div, uint8_t *ms_div_by_4, const int frac_mode)
+{
+	const uint32_t pll_Hz = (vco_den > 0) ? (uint32_t)(vco_num / vco_den) : 0;
+
+	uint32_t a       = 0;
+	uint32_t b       = 0;
+	uint32_t c       = 1;
+	uint8_t r_div    = 0;
+	uint8_t div_by_4 = 0;
+
+	*ms_a        = a;
+	*ms_b        = b;
+	*ms_c        = c;
+	*ms_r_div    = r_div;
+	*ms_div_by_4 = div_by_4;
+
+	if (pll_Hz == 0 || ms_Hz == 0)
+		return 0;
+
+	// compute the required MS output R-divider value (1, 2, 4, 8, 16, 32, 64 or 128)
+	while (r_div < 7 && ms_Hz < SI5351_MS_MIN_HZ)
+	{
+		r_div++;
+		ms_Hz <<= 1;
+	}
+
+	// compute the integer part .. valid MS values are 4, 6 and 8 to 2048, 0 if the VCO frequency can't reach it
+	const uint64_t q   = vco_den * ms_Hz;
+	const uint64_t div = vco_num / q;
+	if (div < 4 || (div > 4 && div < 8) || div > 2048 || (div == 2048 && (vco_num % q) > 0))
+		return 0;
+
+	a = (uint32_t)div;
+	if (a < 8)
+	{	// fixed divide-by-4 mode
+		div_by_4 = 3;
+	}
+	else
+	if (frac_mode == PLL_FRAC_BEST)
+	{	// the b/c that gives the output frequency nearest to the wanted one
+
+		uint32_t bs[2] = {0, 0};
+		uint32_t cs[2] = {1, 1};
+		const unsigned int n = pll_best_fracs(vco_num % q, q, PLL_FRAC_MAX_C, bs, cs);
+
+		const long double vco = (long double)vco_num / vco_den;
+		long double best_err = -1.0;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			const long double err = pll_fabsl((vco * cs[i]) / (((long double)a * cs[i]) + bs[i]) - ms_Hz);
+			if (best_err < 0.0 || best_err > err)
+			{
+				best_err = err;
+				b = bs[i];
+				c = cs[i];
+			}
+		}
+
+		if (b >= c)
+		{	// rounded up to the next integer
+			a += b / c;
+			b  = 0;
+			c  = 1;
+		}
+	}
+	else
+	{	// compute the fractional part
+
+		const uint32_t denom = (1u << 20) - 1;
+		b = ((uint64_t)(pll_Hz % ms_Hz) * denom) / ms_Hz;
+		c = (b > 0) ? denom : 1;
+
+		// optimize the fractional register values
+		if (b && c)
+		{
+			const uint32_t gcd = pll_gcd(b, c);
+			if (gcd > 1)
+			{	// scale down the fractional reg values
+				b /= gcd;
+				c /= gcd;
+			}
+		}
+
+		if (b == 0 || c == 0)
+		{
+			b = 0;
+			c = 1;
+		}
+	}
+
+	// recompute the MS output frequency
+	// ms_Hz = pll_Hz / (a + (b / c))
+	ms_Hz = ((uint64_t)pll_Hz << 20) / (((uint64_t)a << 20) + (((uint64_t)b << 20) / c));
+	ms_Hz >>= r_div;
+
+	*ms_a        = a;
+	*ms_b        = b;
+	*ms_c        = c;
+	*ms_r_div    = r_div;
+	*ms_div_by_4 = div_by_4;
+
+	return ms_Hz;
+}
+
+// multisynth 0 to 5 a/b/c and output dividers for an output frequency, returns the achieved output frequency
+constexpr uint32_t pll_calc_ms(const uint32_t pll_Hz, uint32_t ms_Hz, uint32_t *ms_a, uint32_t *ms_b, uint32_t *ms_c, uint8_t *ms_r_div, uint8_t *ms_div_by_4, const int frac_mode = PLL_FRAC_DENOM)
+{
+	return pll_calc_ms_frac(pll_Hz, 1, ms_Hz, ms_a, ms_b, ms_c, ms_r_div, ms_div_by_4, frac_mode);
+}
+
+// multisynth 6/7 .. the nearest even integer divider, returns the achieved output frequency (0 if it's out of range)
+constexpr uint32_t pll_calc_ms67(const uint32_t pll_Hz, uint32_t ms_Hz, uint32_t *ms_a, uint8_t *ms_r_div)
+{
+	uint8_t r_div = 0;
+
+	*ms_a     = 0;
+	*ms_r_div = 0;
+
+	if (pll_Hz == 0 || ms_Hz == 0)
+		return 0;
+
+	while (r_div < 7 && (uint64_t)ms_Hz * PLL_PLAN_MS67_MAX_DIV < pll_Hz)
+	{
+		r_div++;
+		ms_Hz <<= 1;
+	}
+
+	uint32_t a = (pll_Hz + ms_Hz) / (2 * ms_Hz);	// rounded, halved
+	a *= 2;
+	if (a < PLL_PLAN_MS67_MIN_DIV || a > PLL_PLAN_MS67_MAX_DIV)
+		return 0;
+
+	*ms_a     = a;
+	*ms_r_div = r_div;
+
+	return (pll_Hz / a) >> r_div;
+}
+
+// ****************************************************************
+
+// write an output's settings into the plan's register image
+constexpr void pll_plan_set_regs(t_pll_plan &plan, const unsigned int clk)
+{
+	const t_pll_plan_ms &ms = plan.ms[clk];
+	uint8_t *regs = plan.regs;
+
+	// reg-15 .. CLKIN_DIV = /1, PLL-B_SRC = XTAL, PLL-A_SRC = XTAL
+	regs[SI5351_REG_PLL_INPUT_SOURCE] = (0u << 6) | (0u << 3) | (0u << 2);
+
+	// CLK-n .. Powered UP, Integer/Fractional mode, PLL-A/B as MS source, Not inverted, own MS as CLK source, 8mA CLK output current
+	const bool ms_int = (clk < 6 && (ms.div.a & 1) == 0 && ms.div.b == 0);
+	uint8_t &ctrl = regs[SI5351_REG_CLK0_CONTROL + clk];
+	if (clk < 6)
+		ctrl = (0u << 7) | ((ms_int ? 1u : 0u) << 6) | ((uint8_t)ms.pll << 5) | (0u << 4) | (3u << 2) | (3u << 0);
+	else	// bit 6 of the CLK-6/7 control registers is the PLL-A/B integer mode
+		ctrl = (ctrl & (1u << 6)) | (0u << 7) | ((uint8_t)ms.pll << 5) | (0u << 4) | (3u << 2) | (3u << 0);
+
+	// output enabled
+	regs[SI5351_REG_OUTPUT_ENABLE_CONTROL] &= ~(1u << clk);
+
+	// unused clocks disabled state = HIGH_Z, used clocks disabled state = LOW
+	for (unsigned int k = 0; k < PLL_PLAN_OUTPUTS; k++)
+	{
+		const uint8_t state = (plan.used_clks & (1u << k)) ? 0u : 2u;
+		uint8_t &reg = regs[SI5351_REG_CLK3_0_DISABLE_STATE + (k / 4)];
+		reg = (reg & ~(3u << ((k & 3) * 2))) | (state << ((k & 3) * 2));
+	}
+
+	if (clk < 6)
+	{
+		pll_set_params(&regs[SI5351_REG_MS0_PARAMETERS + (8 * clk)], ms.div.a, ms.div.b, ms.div.c, ms.r_div, ms.div_by_4);
+	}
+	else
+	{
+		regs[SI5351_REG_MS6_PARAMETERS + (clk - 6)] = (uint8_t)ms.div.a;
+
+		const unsigned int shift = (clk == 7) ? 4 : 0;
+		regs[SI5351_REG_MS67_OUTPUT_DIVIDER] = (regs[SI5351_REG_MS67_OUTPUT_DIVIDER] & ~(7u << shift)) | ((ms.r_div & 7u) << shift);
+	}
+}
+
+constexpr void pll_plan_set_pll_regs(t_pll_plan &plan, const unsigned int pll)
+{
+	const t_pll_frac &frac = plan.pll[pll];
+
+	// if "a + (b / c)" is an even number, then INTEGER mode can be enabled - helps to reduce the output jitter
+	uint8_t &reg = plan.regs[SI5351_REG_CLK6_CONTROL + pll];
+	if ((frac.a & 1) == 0 && frac.b == 0)
+		reg |=   1u << 6;	// INT mode
+	else
+		reg &= ~(1u << 6);	// FRAC mode
+
+	pll_set_params(&plan.regs[SI5351_REG_PLLA_PARAMETERS + (8 * pll)], frac.a, frac.b, frac.c, 0, 0);
+}
+
+// exact achieved output frequency from the plan's parameters
+constexpr long double pll_plan_exact_Hz(const t_pll_plan &plan, const unsigned int clk)
+{
+	const t_pll_plan_ms &ms  = plan.ms[clk];
+	const t_pll_frac    &pll = plan.pll[ms.pll];
+
+	if (pll.c == 0 || ms.div.a == 0)
+		return 0.0;
+
+	long double Hz = (long double)plan.ref_Hz * (((long double)pll.a * pll.c) + pll.b) / pll.c;
+
+	if (clk >= 6)
+		Hz /= ms.div.a;
+	else
+	if (ms.div_by_4 == 3)
+		Hz /= 4;
+	else
+		Hz = (Hz * ms.div.c) / (((long double)ms.div.a * ms.div.c) + ms.div.b);
+
+	return Hz / (1u << ms.r_div);
+}
+
+// the achieved frequency (rounded) and its error from the exact one .. what the register image decodes to
+constexpr void pll_plan_set_err(t_pll_plan &plan, const unsigned int clk)
+{
+	const long double Hz = pll_plan_exact_Hz(plan, clk);
+	plan.clk_Hz[clk]      = (uint32_t)(Hz + 0.5);
+	plan.clk_err_uHz[clk] = (double)((Hz - plan.ms[clk].want_Hz) * 1e6);
+}
+
+// take an output back out of the plan (its PLL can't reach it any more) .. powered down and disabled as in pll_plan_start()
+constexpr void pll_plan_drop_output(t_pll_plan &plan, const unsigned int clk)
+{
+	plan.used_clks        &= ~(1u << clk);
+	plan.ms[clk]           = t_pll_plan_ms();
+	plan.ms[clk].div.c     = 1;
+	plan.clk_Hz[clk]       = 0;
+	plan.clk_err_uHz[clk]  = 0.0;
+
+	uint8_t &state = plan.regs[SI5351_REG_CLK3_0_DISABLE_STATE + (clk / 4)];
+	state = (state & ~(3u << ((clk & 3) * 2))) | (2u << ((clk & 3) * 2));	// HIGH_Z
+
+	plan.regs[SI5351_REG_CLK0_CONTROL + clk]   |= 1u << 7;
+	plan.regs[SI5351_REG_OUTPUT_ENABLE_CONTROL] |= 1u << clk;
+}
+
+// start a plan .. nothing planned, on top of a register image (nullptr = all zero, the reset state of every register
+// the plan's burst covers)
+constexpr void pll_plan_start(t_pll_plan &plan, const uint32_t ref_Hz, const int frac_mode, const uint8_t *reset_regs)
+{
+	plan = t_pll_plan();
+
+	plan.ref_Hz    = ref_Hz;
+	plan.frac_mode = frac_mode;
+
+	for (unsigned int pll = 0; pll < 2; pll++)
+		plan.pll[pll].c = 1;
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		plan.ms[clk].div.c = 1;
+
+	if (reset_regs)
+		for (unsigned int reg = 0; reg < 256; reg++)
+			plan.regs[reg] = reset_regs[reg];
+
+	// outputs powered down and disabled until planned
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+		plan.regs[SI5351_REG_CLK0_CONTROL + clk] |= 1u << 7;
+	plan.regs[SI5351_REG_OUTPUT_ENABLE_CONTROL] = 0xff;
+}
+
+// start a plan .. nothing planned, the full reset register image
+void pll_plan_init(t_pll_plan &plan, const uint32_t ref_Hz, const int frac_mode = PLL_FRAC_DENOM);
+
+// further down
+constexpr uint32_t pll_plan_output_from_pll(t_pll_plan &plan, const unsigned int clk, const unsigned int pll, const uint32_t freq_Hz);
+
+// set a PLL's a/b/c directly (a fixed VCO frequency), outputs already on it are re-planned (and dropped if it can't reach them)
+constexpr void pll_plan_set_pll(t_pll_plan &plan, const unsigned int pll, const t_pll_frac &frac)
+{
+	if (pll >= 2 || frac.c == 0)
+		return;
+
+	plan.pll[pll]     = frac;
+	plan.pll_Hz[pll]  = (plan.ref_Hz * frac.a) + (uint32_t)(((uint64_t)plan.ref_Hz * frac.b) / frac.c);
+	plan.used_plls   |= 1u << pll;
+	pll_plan_set_pll_regs(plan, pll);
+
+	for (unsigned int k = 0; k < PLL_PLAN_OUTPUTS; k++)
+		if ((plan.used_clks & (1u << k)) && plan.ms[k].pll == pll)
+			if (pll_plan_output_from_pll(plan, k, pll, plan.ms[k].want_Hz) == 0)
+				pll_plan_drop_output(plan, k);
+}
+
+// set an output (0 to 7) to a frequency, choosing (and setting) the VCO frequency of its PLL for the lowest jitter,
+// other outputs already on that PLL are re-planned from the new VCO frequency (and dropped if it can't reach them) ..
+// returns the achieved frequency, 0 if not possible (the plan is left as it was)
+constexpr uint32_t pll_plan_output(t_pll_plan &plan, const unsigned int clk, const unsigned int pll, const uint32_t freq_Hz)
+{
+	if (clk >= PLL_PLAN_OUTPUTS || pll >= 2 || freq_Hz == 0 || plan.ref_Hz == 0)
+		return 0;
+
+	uint32_t ms_Hz       = freq_Hz;
+	uint32_t ms_a        = 0;
+	uint8_t  ms_r_div    = 0;
+	uint8_t  ms_div_by_4 = 0;
+	uint32_t pll_Hz      = 0;
+
+	// **********
+	// compute the PLL frequency and MS required register values
+
+	if (clk < 6)
+	{
+		// compute the required output R-divider value (1, 2, 4, 8, 16, 32, 64 or 128)
+		while (ms_r_div < 7 && ms_Hz < SI5351_MS_MIN_HZ)
+		{
+			ms_r_div++;
+			ms_Hz <<= 1;
+		}
+
+		// PLL VCO frequency
+		pll_Hz = pll_find_VCO_freq(plan.ref_Hz, ms_Hz);
+
+		if (pll_Hz > 0)
+		{	// found a preferred PLL VCO frequency to use
+			ms_a = pll_Hz / ms_Hz;
+		}
+		else
+		{	// desired even integer PLL divider value not found
+			ms_a = SI5351_PLL_VCO_MAX_HZ / ms_Hz;    // use the maximum VCO frequency we can
+			ms_a -= ms_a & 1u;                       // ensure even to reduce phase noise/jitter .. round down
+		}
+
+		// valid MS divider value is 4 or 8 to 2048
+		if (ms_a < 8)
+		{	// fixed divide-by-4 output mode
+			ms_a = 4;
+			ms_div_by_4 = 3;
+		}
+		else
+		if (ms_a > 2048)
+		{
+			ms_a = 2048;
+		}
+	}
+	else
+	{
+		// the R-divider that brings the multisynth frequency within reach of the VCO
+		while (ms_r_div < 7 && (uint64_t)ms_Hz * PLL_PLAN_MS67_MAX_DIV < SI5351_PLL_VCO_MIN_HZ)
+		{
+			ms_r_div++;
+			ms_Hz <<= 1;
+		}
+
+		// no even divider 6 to 254 puts the VCO in range
+		pll_Hz = pll_find_VCO_freq_ms67(plan.ref_Hz, ms_Hz);
+		if (pll_Hz == 0)
+			return 0;
+
+		ms_a = pll_Hz / ms_Hz;
+	}
+
+	// the VCO frequency the divider needs has to be in range, as does the PLL's multiplier for it
+	const uint64_t vco_Hz = (uint64_t)ms_Hz * ms_a;
+	if (vco_Hz < SI5351_PLL_VCO_MIN_HZ || vco_Hz > SI5351_PLL_VCO_MAX_HZ)
+		return 0;
+	if (vco_Hz < (uint64_t)plan.ref_Hz * 15 || vco_Hz > (uint64_t)plan.ref_Hz * 90)
+		return 0;
+
+	// compute the actual PLL VCO frequency and the PLL reg values
+	t_pll_frac pll_frac = t_pll_frac();
+	pll_Hz = pll_calc_pll(plan.ref_Hz, (uint32_t)vco_Hz, &pll_frac.a, &pll_frac.b, &pll_frac.c, plan.frac_mode);
+	if (pll_Hz < SI5351_PLL_VCO_MIN_HZ || pll_Hz > SI5351_PLL_VCO_MAX_HZ)
+		return 0;
+
+	plan.pll[pll]     = pll_frac;
+	plan.pll_Hz[pll]  = pll_Hz;
+	plan.used_plls   |= 1u << pll;
+	pll_plan_set_pll_regs(plan, pll);
+
+	// **********
+	// save the results
+
+	t_pll_plan_ms &ms = plan.ms[clk];
+	ms.div.a    = ms_a;
+	ms.div.b    = 0;
+	ms.div.c    = 1;
+	ms.r_div    = ms_r_div;
+	ms.div_by_4 = ms_div_by_4;
+	ms.pll      = (uint8_t)pll;
+	ms.want_Hz  = freq_Hz;
+
+	// the achieved output frequency
+	plan.used_clks   |= 1u << clk;
+	pll_plan_set_regs(plan, clk);
+	pll_plan_set_err(plan, clk);
+
+	// the other outputs on this PLL follow its new VCO frequency
+	for (unsigned int k = 0; k < PLL_PLAN_OUTPUTS; k++)
+		if (k != clk && (plan.used_clks & (1u << k)) && plan.ms[k].pll == pll)
+			if (pll_plan_output_from_pll(plan, k, pll, plan.ms[k].want_Hz) == 0)
+				pll_plan_drop_output(plan, k);
+
+	return plan.clk_Hz[clk];
+}
+
+// set an output to a frequency from the PLL's current VCO frequency (fractional multisynth), returns the achieved frequency,
+// 0 if the VCO frequency can't reach it (the plan is left as it was)
+constexpr uint32_t pll_plan_output_from_pll(t_pll_plan &plan, const unsigned int clk, const unsigned int pll, const uint32_t freq_Hz)
+{
+	if (clk >= PLL_PLAN_OUTPUTS || pll >= 2 || freq_Hz == 0 || !(plan.used_plls & (1u << pll)))
+		return 0;
+
+	const uint32_t pll_Hz = plan.pll_Hz[pll];
+	if (pll_Hz < SI5351_PLL_VCO_MIN_HZ || pll_Hz > SI5351_PLL_VCO_MAX_HZ)
+		return 0;
+
+	t_pll_plan_ms ms = t_pll_plan_ms();
+	ms.pll     = (uint8_t)pll;
+	ms.want_Hz = freq_Hz;
+
+	uint32_t clk_Hz = 0;
+
+	if (clk < 6)
+	{
+		uint64_t vco_num = pll_Hz;
+		uint64_t vco_den = 1;
+		if (plan.frac_mode == PLL_FRAC_BEST)
+		{	// from the exact VCO frequency
+			const t_pll_frac &frac = plan.pll[pll];
+			vco_num = (uint64_t)plan.ref_Hz * (((uint64_t)frac.a * frac.c) + frac.b);
+			vco_den = frac.c;
+		}
+		clk_Hz = pll_calc_ms_frac(vco_num, vco_den, freq_Hz, &ms.div.a, &ms.div.b, &ms.div.c, &ms.r_div, &ms.div_by_4, plan.frac_mode);
+	}
+	else
+	{
+		clk_Hz = pll_calc_ms67(pll_Hz, freq_Hz, &ms.div.a, &ms.r_div);
+		ms.div.b    = 0;
+		ms.div.c    = 1;
+		ms.div_by_4 = 0;
+	}
+
+	if (clk_Hz == 0)
+		return 0;
+
+	plan.ms[clk]    = ms;
+	plan.used_clks |= 1u << clk;
+	pll_plan_set_regs(plan, clk);
+	pll_plan_set_err(plan, clk);
+
+	return plan.clk_Hz[clk];
+}
+
+// the plan's I2C burst .. start register address then registers 15 up to the last planned multisynth, returns the byte count
+constexpr unsigned int pll_plan_buffer(const t_pll_plan &plan, uint8_t *buffer)
+{
+	// the first Si5351 register the buffer uses
+	const unsigned int start_reg = SI5351_REG_PLL_INPUT_SOURCE;
+
+	// up to the last planned multisynth (at least the PLL parameters)
+	unsigned int last_reg = SI5351_REG_PLLB_PARAMETERS + 7;
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (!(plan.used_clks & (1u << clk)))
+			continue;
+		const unsigned int reg = (clk < 6) ? SI5351_REG_MS0_PARAMETERS + (8 * clk) + 7 : SI5351_REG_MS67_OUTPUT_DIVIDER;
+		if (last_reg < reg)
+			last_reg = reg;
+	}
+
+	// start byte is the initial register address
+	buffer[0] = start_reg;
+	for (unsigned int reg = start_reg; reg <= last_reg; reg++)
+		buffer[1 + reg - start_reg] = plan.regs[reg];
+
+	return 1 + last_reg - start_reg + 1;
+}
+
+// ****************************************************************
+// compile time plans
+
+// CLK-n at clk_Hz[n] (0 = not used) on PLL clk_pll[n] .. the first output on each PLL sets its VCO frequency, the
+// others on it are fractional from there
+constexpr t_pll_plan pll_plan_fixed(const uint32_t ref_Hz, const uint32_t (&clk_Hz)[PLL_PLAN_OUTPUTS], const uint8_t (&clk_pll)[PLL_PLAN_OUTPUTS], const int frac_mode = PLL_FRAC_DENOM)
+{
+	t_pll_plan plan = t_pll_plan();
+	pll_plan_start(plan, ref_Hz, frac_mode, nullptr);
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (clk_Hz[clk] == 0 || clk_pll[clk] >= 2)
+			continue;
+		if (plan.used_plls & (1u << clk_pll[clk]))
+			pll_plan_output_from_pll(plan, clk, clk_pll[clk], clk_Hz[clk]);
+		else
+			pll_plan_output(plan, clk, clk_pll[clk], clk_Hz[clk]);
+	}
+
+	return plan;
+}
+
+// true if every planned PLL and multisynth is within the Si5351 limits .. for static_assert()
+constexpr bool pll_plan_valid(const t_pll_plan &plan)
+{
+	for (unsigned int pll = 0; pll < 2; pll++)
+	{
+		if (!(plan.used_plls & (1u << pll)))
+			continue;
+		const t_pll_frac &f = plan.pll[pll];
+		if (f.a < 15 || f.a > 90 || f.c == 0 || f.c > PLL_FRAC_MAX_C || f.b >= f.c)
+			return false;
+		if (plan.pll_Hz[pll] < SI5351_PLL_VCO_MIN_HZ || plan.pll_Hz[pll] > SI5351_PLL_VCO_MAX_HZ)
+			return false;
+	}
+
+	for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+	{
+		if (!(plan.used_clks & (1u << clk)))
+			continue;
+		const t_pll_plan_ms &ms = plan.ms[clk];
+		if (!(plan.used_plls & (1u << ms.pll)) || plan.clk_Hz[clk] == 0 || ms.r_div > 7)
+			return false;
+		if (clk >= 6)
+		{
+			if ((ms.div.a & 1) || ms.div.a < PLL_PLAN_MS67_MIN_DIV || ms.div.a > PLL_PLAN_MS67_MAX_DIV)
+				return false;
+		}
+		else
+		if (ms.div_by_4 == 3)
+		{
+			if (ms.div.a != 4 || ms.div.b != 0)
+				return false;
+		}
+		else
+		{
+			if (ms.div.a < 8 || ms.div.a > 2048 || (ms.div.a == 2048 && ms.div.b > 0))
+				return false;
+			if (ms.div.c == 0 || ms.div.c > PLL_FRAC_MAX_C || ms.div.b >= ms.div.c)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// the plan's I2C burst as a value
+constexpr t_pll_plan_blob pll_plan_blob(const t_pll_plan &plan)
+{
+	t_pll_plan_blob blob = t_pll_plan_blob();
+	blob.size = pll_plan_buffer(plan, blob.data);
+	return blob;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Si5351 I2C data decoder
+//
+// Redundant write analysis .. which written bytes didn't change the register image
+
+#include <string.h>
+
+#include "si5351.h"
+#include "i2cbus.h"
+#include "redundant.h"
+
+// ****************************************************************
+
+void t_redundant_writes::clear()
+{
+	memset(&reg[0], 0, sizeof(reg));
+	lines.clear();
+	middle_runs.clear();
+	bytes                  = 0;
+	values                 = 0;
+	redundant              = 0;
+	transactions           = 0;
+	redundant_transactions = 0;
+}
+
+void t_redundant_writes::build(const t_capture &capture)
+{
+	clear();
+
+	uint8_t regs[256];
+	si5351_reset_regs(regs);
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size = capture.lineDataSize(i);
+		const uint8_t     *data = capture.lineData(i);
+
+		if (size == 0)
+			continue;
+
+		// clear the PLL self clearing bits
+		regs[SI5351_REG_PLL_RESET] &= 0x5f;
+
+		t_redundant_line line;
+		line.line         = i;
+		line.bytes        = 0;
+		line.redundant    = 0;
+		line.leading_run  = 0;
+		line.trailing_run = 0;
+		line.middle_first = (uint32_t)middle_runs.size();
+		line.middle_count = 0;
+
+		int run       = 0;      // current run of redundant values
+		int run_start = 1;
+
+		int addr = data[0];
+		for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+		{
+			const uint8_t value = data[k];
+
+			// a PLL reset is an action, never redundant
+			const bool is_redundant = (regs[addr] == value) && !(addr == SI5351_REG_PLL_RESET && (value & 0xa0));
+
+			reg[addr].writes++;
+			line.bytes++;
+			if (is_redundant)
+			{
+				reg[addr].redundant++;
+				line.redundant++;
+				if (run++ == 0)
+					run_start = k;
+			}
+			else
+			if (run > 0)
+			{
+				if (run_start == 1)
+					line.leading_run = (uint16_t)run;
+				else
+				{
+					middle_runs.push_back((uint16_t)run);
+					line.middle_count++;
+				}
+				run = 0;
+			}
+
+			regs[addr] = value;
+		}
+
+		if (run > 0)
+		{	// trailing run (the whole burst if it's also the leading one)
+			if (run_start == 1)
+				line.leading_run = (uint16_t)run;
+			else
+				line.trailing_run = (uint16_t)run;
+		}
+
+		bytes  += size;
+		values += line.bytes;
+		redundant += line.redundant;
+		transactions++;
+		if (line.bytes > 0 && line.redundant == line.bytes)
+			redundant_transactions++;
+
+		lines.push_back(line);
+	}
+}
+
+double t_redundant_writes::busSecs(const double scl_Hz) const
+{
+	if (scl_Hz <= 0.0 || transactions == 0)
+		return 0.0;
+	return (((double)transactions * i2c_write_clocks(0) + (double)bytes * I2C_BITS_PER_BYTE) / scl_Hz) + ((transactions - 1) * i2c_bus_free_secs(scl_Hz));
+}
+
+double t_redundant_writes::lineSavedSecs(const t_redundant_line &line, const double scl_Hz) const
+{
+	if (scl_Hz <= 0.0 || line.redundant == 0)
+		return 0.0;
+
+	// the whole transaction and the bus free time after it go
+	if (line.redundant == line.bytes)
+		return i2c_write_secs(1 + line.bytes, scl_Hz) + i2c_bus_free_secs(scl_Hz);
+
+	const double byte_secs  = I2C_BITS_PER_BYTE / scl_Hz;
+	const double split_secs = i2c_transaction_overhead_secs(scl_Hz);
+
+	// just start the burst further along/end it sooner
+	double secs = (line.leading_run + line.trailing_run) * byte_secs;
+
+	// a run in the middle means a 2nd transaction
+	for (unsigned int i = 0; i < line.middle_count; i++)
+	{
+		const double run_secs = middle_runs[line.middle_first + i] * byte_secs;
+		if (run_secs > split_secs)
+			secs += run_secs - split_secs;
+	}
+
+	return secs;
+}
+
+double t_redundant_writes::wastedSecs(const double scl_Hz) const
+{
+	double secs = 0.0;
+	for (unsigned int i = 0; i < lines.size(); i++)
+		secs += lineSavedSecs(lines[i], scl_Hz);
+	return secs;
+}
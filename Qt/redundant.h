@@ -0,0 +1,61 @@
+// Si5351 I2C data decoder
+//
+// Redundant write analysis .. which written bytes didn't change the register image
+
+#ifndef REDUNDANT_H
+#define REDUNDANT_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+
+struct t_redundant_reg
+{
+	uint32_t writes;
+	uint32_t redundant;     // writes of the value the register already held
+};
+
+struct t_redundant_line
+{
+	uint32_t line;
+	uint16_t bytes;         // register values written
+	uint16_t redundant;     //   "  of those that were redundant
+	uint16_t leading_run;   // redundant values at the start of the burst
+	uint16_t trailing_run;  //   "   at the end (not counting a leading run that covers the whole burst)
+	uint32_t middle_first;  // the runs in between are middle_runs[middle_first .. middle_first + middle_count - 1]
+	uint16_t middle_count;
+};
+
+struct t_redundant_writes
+{
+	t_redundant_reg reg[256];
+
+	std::vector <t_redundant_line> lines;   // every line that wrote something, in line order
+	std::vector <uint16_t>         middle_runs;   // the lengths of the redundant runs in the middle of a burst
+
+	uint64_t bytes;                 // I2C bytes after the device address (register address + values)
+	uint64_t values;                // register values written
+	uint64_t redundant;             //   "   that were redundant
+	uint32_t transactions;
+	uint32_t redundant_transactions;    // transactions where every value was redundant
+
+	t_redundant_writes() { clear(); }
+
+	void clear();
+
+	void build(const t_capture &capture);
+
+	// estimated bus time of the whole capture (including the bus free time between the transactions)
+	double busSecs(const double scl_Hz) const;
+
+	// bus time that dropping a line's redundant values would save .. leading/trailing runs are trimmed, a whole redundant
+	// transaction is dropped with its bus free time, and a run in the middle only counts if splitting the burst in two
+	// is cheaper (the same i2c_transaction_overhead_secs() rule the write sequence planner bridges gaps by)
+	double lineSavedSecs(const t_redundant_line &line, const double scl_Hz) const;
+
+	// the same for every line
+	double wastedSecs(const double scl_Hz) const;
+};
+
+#endif
@@ -0,0 +1,284 @@
+// Si5351 I2C data decoder
+//
+// Redundant write window .. the written bytes that didn't change anything, per register and per line
+
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QSplitter>
+
+#include <algorithm>
+
+#include "si5351.h"
+#include "redundantwindow.h"
+
+// bus rate the per line saving is shown at
+#define REDUNDANT_LINE_SCL_HZ   400000.0
+
+// ****************************************************************
+
+RedundantWritesModel::RedundantWritesModel(const bool by_line, QObject *parent) :
+	QAbstractTableModel(parent),
+	m_writes(nullptr),
+	m_by_line(by_line)
+{
+}
+
+int RedundantWritesModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid() || !m_writes)
+		return 0;
+	return (int)m_rows.size();
+}
+
+int RedundantWritesModel::columnCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return m_by_line ? REDUNDANT_LINE_COLUMNS : REDUNDANT_REG_COLUMNS;
+}
+
+QVariant RedundantWritesModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	if (m_by_line)
+	{
+		switch (section)
+		{
+			case REDUNDANT_LINE_COL_LINE:      return QString("Line");
+			case REDUNDANT_LINE_COL_VALUES:    return QString("Values");
+			case REDUNDANT_LINE_COL_REDUNDANT: return QString("Redundant");
+			case REDUNDANT_LINE_COL_SAVED:     return QString("Saving @ 400kHz");
+		}
+	}
+	else
+	{
+		switch (section)
+		{
+			case REDUNDANT_REG_COL_ADDR:       return QString("Reg");
+			case REDUNDANT_REG_COL_NAME:       return QString("Name");
+			case REDUNDANT_REG_COL_WRITES:     return QString("Writes");
+			case REDUNDANT_REG_COL_REDUNDANT:  return QString("Redundant");
+			case REDUNDANT_REG_COL_PERCENT:    return QString("%");
+		}
+	}
+
+	return QVariant();
+}
+
+QVariant RedundantWritesModel::data(const QModelIndex &index, int role) const
+{
+	if (!m_writes || !index.isValid() || index.row() < 0 || index.row() >= (int)m_rows.size())
+		return QVariant();
+
+	if (role == Qt::TextAlignmentRole)
+	{
+		if (!m_by_line && index.column() == REDUNDANT_REG_COL_NAME)
+			return (int)(Qt::AlignLeft | Qt::AlignVCenter);
+		return (int)(Qt::AlignRight | Qt::AlignVCenter);
+	}
+
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	const uint32_t item = m_rows[index.row()];
+	QString s;
+
+	if (m_by_line)
+	{
+		const t_redundant_line &line = m_writes->lines[item];
+		switch (index.column())
+		{
+			case REDUNDANT_LINE_COL_LINE:      return QString::number(1 + line.line);
+			case REDUNDANT_LINE_COL_VALUES:    return QString::number(line.bytes);
+			case REDUNDANT_LINE_COL_REDUNDANT: return QString::number(line.redundant);
+			case REDUNDANT_LINE_COL_SAVED:     s.sprintf("%0.1f us", m_writes->lineSavedSecs(line, REDUNDANT_LINE_SCL_HZ) * 1e6); return s;
+		}
+		return QVariant();
+	}
+
+	const t_redundant_reg &reg = m_writes->reg[item];
+	switch (index.column())
+	{
+		case REDUNDANT_REG_COL_ADDR:
+			return QString::number(item);
+		case REDUNDANT_REG_COL_NAME:
+			for (unsigned int i = 0; i < si5351_reg_list_count; i++)
+				if (si5351_reg_list[i].addr == (int)item)
+					return QString(si5351_reg_list[i].name);
+			return QString("");
+		case REDUNDANT_REG_COL_WRITES:
+			return QString::number(reg.writes);
+		case REDUNDANT_REG_COL_REDUNDANT:
+			return QString::number(reg.redundant);
+		case REDUNDANT_REG_COL_PERCENT:
+			s.sprintf("%0.1f", (reg.writes > 0) ? reg.redundant * 100.0 / reg.writes : 0.0);
+			return s;
+	}
+
+	return QVariant();
+}
+
+double RedundantWritesModel::sortKey(const uint32_t item, const int column) const
+{
+	if (m_by_line)
+	{
+		const t_redundant_line &line = m_writes->lines[item];
+		switch (column)
+		{
+			case REDUNDANT_LINE_COL_VALUES:    return line.bytes;
+			case REDUNDANT_LINE_COL_REDUNDANT: return line.redundant;
+			case REDUNDANT_LINE_COL_SAVED:     return m_writes->lineSavedSecs(line, REDUNDANT_LINE_SCL_HZ);
+		}
+		return line.line;
+	}
+
+	const t_redundant_reg &reg = m_writes->reg[item];
+	switch (column)
+	{
+		case REDUNDANT_REG_COL_WRITES:    return reg.writes;
+		case REDUNDANT_REG_COL_REDUNDANT: return reg.redundant;
+		case REDUNDANT_REG_COL_PERCENT:   return (reg.writes > 0) ? (double)reg.redundant / reg.writes : 0.0;
+	}
+	return item;
+}
+
+void RedundantWritesModel::sort(int column, Qt::SortOrder order)
+{
+	if (!m_writes)
+		return;
+
+	emit layoutAboutToBeChanged();
+
+	// stable on the register address/line
+	std::vector < std::pair <double, uint32_t> > keys(m_rows.size());
+	for (unsigned int row = 0; row < keys.size(); row++)
+		keys[row] = std::make_pair(sortKey(m_rows[row], column), m_rows[row]);
+
+	if (order == Qt::AscendingOrder)
+		std::sort(keys.begin(), keys.end());
+	else
+		std::sort(keys.begin(), keys.end(), [](const std::pair <double, uint32_t> &a, const std::pair <double, uint32_t> &b)
+		{
+			return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+		});
+
+	for (unsigned int row = 0; row < keys.size(); row++)
+		m_rows[row] = keys[row].second;
+
+	emit layoutChanged();
+}
+
+void RedundantWritesModel::setWrites(const t_redundant_writes *writes)
+{
+	beginResetModel();
+
+	m_writes = writes;
+	m_rows.clear();
+
+	if (writes)
+	{
+		if (m_by_line)
+		{
+			for (unsigned int i = 0; i < writes->lines.size(); i++)
+				if (writes->lines[i].redundant > 0)
+					m_rows.push_back(i);
+		}
+		else
+		{
+			for (unsigned int addr = 0; addr < 256; addr++)
+				if (writes->reg[addr].writes > 0)
+					m_rows.push_back(addr);
+		}
+	}
+
+	endResetModel();
+}
+
+int RedundantWritesModel::rowLine(const int row) const
+{
+	if (!m_writes || !m_by_line || row < 0 || row >= (int)m_rows.size())
+		return -1;
+	return (int)m_writes->lines[m_rows[row]].line;
+}
+
+// ****************************************************************
+
+RedundantWritesWindow::RedundantWritesWindow(QWidget *parent) :
+	QWidget(parent, Qt::Window)
+{
+	setWindowTitle("Redundant writes");
+
+	m_reg_model  = new RedundantWritesModel(false, this);
+	m_line_model = new RedundantWritesModel(true, this);
+
+	m_summary_label = new QLabel(this);
+
+	QTableView *views[2];
+	RedundantWritesModel *models[2] = {m_reg_model, m_line_model};
+
+	QSplitter *splitter = new QSplitter(Qt::Horizontal, this);
+
+	for (int i = 0; i < 2; i++)
+	{
+		views[i] = new QTableView(splitter);
+		views[i]->setModel(models[i]);
+		views[i]->setSelectionBehavior(QAbstractItemView::SelectRows);
+		views[i]->setSelectionMode(QAbstractItemView::SingleSelection);
+		views[i]->setSortingEnabled(true);
+		views[i]->verticalHeader()->setVisible(false);
+		splitter->addWidget(views[i]);
+	}
+
+	m_reg_view  = views[0];
+	m_line_view = views[1];
+	connect(m_line_view, SIGNAL(clicked(QModelIndex)), this, SLOT(onLineClicked(QModelIndex)));
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addWidget(m_summary_label);
+	layout->addWidget(splitter, 1);
+
+	resize(900, 500);
+}
+
+void RedundantWritesWindow::setWrites(const t_redundant_writes *writes)
+{
+	m_reg_model->setWrites(writes);
+	m_line_model->setWrites(writes);
+
+	if (!writes)
+	{
+		m_summary_label->setText("");
+		return;
+	}
+
+	QString s;
+	s.sprintf("%llu of %llu register values written were redundant (%0.1f%%), %u of %u transactions wrote nothing new\n",
+		(unsigned long long)writes->redundant,
+		(unsigned long long)writes->values,
+		(writes->values > 0) ? writes->redundant * 100.0 / writes->values : 0.0,
+		writes->redundant_transactions,
+		writes->transactions);
+
+	const double scl_Hz[3] = {100e3, 400e3, 1000e3};
+	for (int i = 0; i < 3; i++)
+	{
+		QString s2;
+		s2.sprintf("%s%0.0fkHz bus time %0.3f ms, %0.3f ms of it redundant",
+			(i > 0) ? " .. " : "",
+			scl_Hz[i] / 1e3,
+			writes->busSecs(scl_Hz[i]) * 1e3,
+			writes->wastedSecs(scl_Hz[i]) * 1e3);
+		s += s2;
+	}
+
+	m_summary_label->setText(s);
+}
+
+void RedundantWritesWindow::onLineClicked(const QModelIndex &index)
+{
+	const int line = m_line_model->rowLine(index.row());
+	if (line >= 0)
+		emit lineClicked(line);
+}
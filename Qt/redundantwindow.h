@@ -0,0 +1,85 @@
+// Si5351 I2C data decoder
+//
+// Redundant write window .. the written bytes that didn't change anything, per register and per line
+
+#ifndef REDUNDANTWINDOW_H
+#define REDUNDANTWINDOW_H
+
+#include <QWidget>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QLabel>
+
+#include <vector>
+
+#include "redundant.h"
+
+// the register table
+#define REDUNDANT_REG_COL_ADDR        0
+#define REDUNDANT_REG_COL_NAME        1
+#define REDUNDANT_REG_COL_WRITES      2
+#define REDUNDANT_REG_COL_REDUNDANT   3
+#define REDUNDANT_REG_COL_PERCENT     4
+#define REDUNDANT_REG_COLUMNS         5
+
+// the line table
+#define REDUNDANT_LINE_COL_LINE       0
+#define REDUNDANT_LINE_COL_VALUES     1
+#define REDUNDANT_LINE_COL_REDUNDANT  2
+#define REDUNDANT_LINE_COL_SAVED      3
+#define REDUNDANT_LINE_COLUMNS        4
+
+// rows are either the registers written, or the lines with redundant writes in them
+class RedundantWritesModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	RedundantWritesModel(const bool by_line, QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+	// the analysis must stay alive (and unchanged) until the next setWrites() call
+	void setWrites(const t_redundant_writes *writes);
+
+	// capture line of a row (line table only)
+	int rowLine(const int row) const;
+
+private:
+	const t_redundant_writes *m_writes;
+
+	bool m_by_line;
+
+	std::vector <uint32_t> m_rows;    // row -> register address or index into m_writes->lines
+
+	double sortKey(const uint32_t item, const int column) const;
+};
+
+class RedundantWritesWindow : public QWidget
+{
+	Q_OBJECT
+
+public:
+	RedundantWritesWindow(QWidget *parent = nullptr);
+
+	void setWrites(const t_redundant_writes *writes);
+
+signals:
+	void lineClicked(int line);
+
+private slots:
+	void onLineClicked(const QModelIndex &index);
+
+private:
+	RedundantWritesModel *m_reg_model;
+	RedundantWritesModel *m_line_model;
+	QLabel               *m_summary_label;
+	QTableView           *m_reg_view;
+	QTableView           *m_line_view;
+};
+
+#endif
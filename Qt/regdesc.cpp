@@ -0,0 +1,787 @@
+// Si5351 I2C data decoder
+//
+// Register setting descriptions and the shared (addr, value) description cache
+
+#include <QMutexLocker>
+
+#include "si5351.h"
+#include "regdesc.h"
+
+// ****************************************************************
+
+QString si5351_reg_description(const int addr, const uint8_t value)
+{
+	QString s = "--";
+
+	switch (addr)
+	{
+		case SI5351_REG_DEVICE_STATUS:
+			s  = (value & 0x80) ? " SYS_INIT"   : " sys_init";
+			s += (value & 0x40) ? "  LOL_B"     : "  lol_b";
+			s += (value & 0x20) ? "  LOL_A"     : "  lol_a";
+			s += (value & 0x10) ? "  LOS_CLKIN" : "  los_clkin";
+			s += (value & 0x08) ? "  LOS_XTAL"  : "  los_xtal";
+			s += (value & 0x04) ? "  RESERVED"  : "  reserved";
+			s += "  RevID-" + QString::number(value & 0x03);
+			break;
+		case SI5351_REG_INTERRUPT_STATUS_STICKY:
+			s  = (value & 0x80) ? " SYS_INIT_STKY"   : " sys_init_stky";
+			s += (value & 0x40) ? "  LOL_B_STKY"     : "  lol_b_stky";
+			s += (value & 0x20) ? "  LOL_A_STKY"     : "  lol_a_stky";
+			s += (value & 0x10) ? "  LOS_CLKIN_STKY" : "  los_clkin_stky";
+			s += (value & 0x08) ? "  LOS_XTAL_STKY"  : "  los_xtal_stky";
+			s += (value & 0x04) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x02) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x01) ? "  RESERVED"       : "  reserved";
+			break;
+		case SI5351_REG_INTERRUPT_STATUS_MASK:
+			s  = (value & 0x80) ? " SYS_INIT_MASK"   : " sys_init_mask";
+			s += (value & 0x40) ? "  LOL_B_MASK"     : "  lol_b_mask";
+			s += (value & 0x20) ? "  LOL_A_MASK"     : "  lol_a_mask";
+			s += (value & 0x10) ? "  LOS_CLKIN_MASK" : "  los_clkin_mask";
+			s += (value & 0x08) ? "  LOS_XTAL_MASK"  : "  los_xtal_mask";
+			s += (value & 0x04) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x02) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x01) ? "  RESERVED"       : "  reserved";
+			break;
+
+		case SI5351_REG_OUTPUT_ENABLE_CONTROL:
+			s  = (value & 0x80) ? " CLK-7   "  : " clk-7-EN";
+			s += (value & 0x40) ? "  CLK-6   " : "  clk-6-EN";
+			s += (value & 0x20) ? "  CLK-5   " : "  clk-5-EN";
+			s += (value & 0x10) ? "  CLK-4   " : "  clk-4-EN";
+			s += (value & 0x08) ? "  CLK-3   " : "  clk-3-EN";
+			s += (value & 0x04) ? "  CLK-2   " : "  clk-2-EN";
+			s += (value & 0x02) ? "  CLK-1   " : "  clk-1-EN";
+			s += (value & 0x01) ? "  CLK-0   " : "  clk-0-EN";
+			break;
+		case SI5351_REG_OEB_PIN_ENABLE_CONTROL:
+			s  = (value & 0x80) ? " OEB-7"  : " oeb-7";
+			s += (value & 0x40) ? "  OEB-6" : "  oeb-6";
+			s += (value & 0x20) ? "  OEB-5" : "  oeb-5";
+			s += (value & 0x10) ? "  OEB-4" : "  oeb-4";
+			s += (value & 0x08) ? "  OEB-3" : "  oeb-3";
+			s += (value & 0x04) ? "  OEB-2" : "  oeb-2";
+			s += (value & 0x02) ? "  OEB-1" : "  oeb-1";
+			s += (value & 0x01) ? "  OEB-0" : "  oeb-0";
+			break;
+
+		case SI5351_REG_PLL_INPUT_SOURCE:
+			s  = " CLKIN_DIV-" + QString::number((value >> 6) & 0x03);
+			s += (value & 0x20) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x10) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x08) ? "  PLLB_SRC-CLKIN" : "  PLLB_SRC-XTAL";
+			s += (value & 0x04) ? "  PLLA_SRC-CLKIN" : "  PLLA_SRC-XTAL";
+			s += (value & 0x02) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x01) ? "  RESERVED"       : "  reserved";
+			break;
+
+		case SI5351_REG_CLK0_CONTROL:
+			s  = (value & 0x80) ? " CLK0_PDN-DN"   : " clk0_pdn-UP";
+			s += (value & 0x40) ? "  MS0_INT-INT " : "  ms0_int-FRAC";
+			s += (value & 0x20) ? "  MS0_SRC-PLLB" : "  ms0_src-PLLA";
+			s += (value & 0x10) ? "  CLK0_INV"     : "  clk0_inv";
+
+			s += "  CLK0_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "RES'D"; break;
+				case 3: s += "MS0  "; break;
+			}
+
+			s += "  CLK0_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK1_CONTROL:
+			s  = (value & 0x80) ? " CLK1_PDN-DN"   : " clk1_pdn-UP";
+			s += (value & 0x40) ? "  MS1_INT-INT " : "  ms1_int-FRAC";
+			s += (value & 0x20) ? "  MS1_SRC-PLLB" : "  ms1_src-PLLA";
+			s += (value & 0x10) ? "  CLK1_INV"     : "  clk1_inv";
+
+			s += "  CLK1_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS0  "; break;
+				case 3: s += "MS1  "; break;
+			}
+
+			s += "  CLK1_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK2_CONTROL:
+			s  = (value & 0x80) ? " CLK2_PDN-DN"   : " clk2_pdn-UP";
+			s += (value & 0x40) ? "  MS2_INT-INT " : "  ms2_int-FRAC";
+			s += (value & 0x20) ? "  MS2_SRC-PLLB" : "  ms2_src-PLLA";
+			s += (value & 0x10) ? "  CLK2_INV"     : "  clk2_inv";
+
+			s += "  CLK2_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS0  "; break;
+				case 3: s += "MS2  "; break;
+			}
+
+			s += "  CLK2_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK3_CONTROL:
+			s  = (value & 0x80) ? " CLK3_PDN-DN"   : " clk3_pdn-UP";
+			s += (value & 0x40) ? "  MS3_INT-INT " : "  ms3_int-FRAC";
+			s += (value & 0x20) ? "  MS3_SRC-PLLB" : "  ms3_src-PLLA";
+			s += (value & 0x10) ? "  CLK3_INV"     : "  clk3_inv";
+
+			s += "  CLK3_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS0  "; break;
+				case 3: s += "MS3  "; break;
+			}
+
+			s += "  CLK3_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK4_CONTROL:
+			s  = (value & 0x80) ? " CLK4_PDN-DN"   : " clk4_pdn-UP";
+			s += (value & 0x40) ? "  MS4_INT-INT " : "  ms4_int-FRAC";
+			s += (value & 0x20) ? "  MS4_SRC-PLLB" : "  ms4_src-PLLA";
+			s += (value & 0x10) ? "  CLK4_INV"     : "  clk4_inv";
+
+			s += "  CLK4_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "RES'D "; break;
+				case 3: s += "MS4  "; break;
+			}
+
+			s += "  CLK4_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK5_CONTROL:
+			s  = (value & 0x80) ? " CLK5_PDN-DN"   : " clk5_pdn-UP";
+			s += (value & 0x40) ? "  MS5_INT-INT " : "  ms5_int-FRAC";
+			s += (value & 0x20) ? "  MS5_SRC-PLLB" : "  ms5_src-PLLA";
+			s += (value & 0x10) ? "  CLK5_INV"     : "  clk5_inv";
+
+			s += "  CLK5_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS4  "; break;
+				case 3: s += "MS5  "; break;
+			}
+
+			s += "  CLK5_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK6_CONTROL:
+			s  = (value & 0x80) ? " CLK6_PDN-DN"   : " clk6_pdn-UP";
+			s += (value & 0x40) ? "  MS6_INT-INT " : "  ms6_int-FRAC";
+			s += (value & 0x20) ? "  MS6_SRC-PLLB" : "  ms6_src-PLLA";
+			s += (value & 0x10) ? "  CLK6_INV"     : "  clk6_inv";
+
+			s += "  CLK6_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS4  "; break;
+				case 3: s += "MS6  "; break;
+			}
+
+			s += "  CLK6_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+		case SI5351_REG_CLK7_CONTROL:
+			s  = (value & 0x80) ? " CLK7_PDN-DN"   : " clk7_pdn-UP";
+			s += (value & 0x40) ? "  MS7_INT-INT " : "  ms7_int-FRAC";
+			s += (value & 0x20) ? "  MS7_SRC-PLLB" : "  ms7_src-PLLA";
+			s += (value & 0x10) ? "  CLK7_INV"     : "  clk7_inv";
+
+			s += "  CLK7_SRC-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "XTAL "; break;
+				case 1: s += "CLKIN"; break;
+				case 2: s += "MS4  "; break;
+				case 3: s += "MS7  "; break;
+			}
+
+			s += "  CLK7_IDRV-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "2mA"; break;
+				case 1: s += "4mA"; break;
+				case 2: s += "6mA"; break;
+				case 3: s += "8mA"; break;
+			}
+			break;
+
+		case SI5351_REG_CLK3_0_DISABLE_STATE:
+			s  = " CLK3_DIS_STATE-";
+			switch ((value >> 6) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK2_DIS_STATE-";
+			switch ((value >> 4) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK1_DIS_STATE-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK0_DIS_STATE-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			break;
+		case SI5351_REG_CLK7_4_DISABLE_STATE:
+			s  = " CLK7_DIS_STATE-";
+			switch ((value >> 6) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK6_DIS_STATE-";
+			switch ((value >> 4) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK5_DIS_STATE-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			s += "  CLK4_DIS_STATE-";
+			switch ((value >> 0) & 0x03)
+			{
+				case 0: s += "LOW    "; break;
+				case 1: s += "HIGH   "; break;
+				case 2: s += "HIGH-Z "; break;
+				case 3: s += "ENABLED"; break;
+			}
+			break;
+
+		case SI5351_REG_PLLA_PARAMETERS + 0:
+			s = " MSNA_P3[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 1:
+			s = " MSNA_P3[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 2:
+			s  = " Reserved-" + QString::number((value >> 2) & 0x03);
+			s += "  MSNA_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 3:
+			s = " MSNA_P1[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 4:
+			s = " MSNA_P1[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 5:
+			s  = " MSNA_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MSNA_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 6:
+			s = " MSNA_P2[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLA_PARAMETERS + 7:
+			s = " MSNA_P2[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+
+		case SI5351_REG_PLLB_PARAMETERS + 0:
+			s = " MSNB_P3[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 1:
+			s = " MSNB_P3[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 2:
+			s  = " Reserved-" + QString::number((value >> 2) & 0x03);
+			s += "  MSNB_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 3:
+			s = " MSNB_P1[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 4:
+			s = " MSNB_P1[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 5:
+			s  = " MSNB_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MSNB_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 6:
+			s = " MSNB_P2[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_PLLB_PARAMETERS + 7:
+			s = " MSNB_P2[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+
+		case SI5351_REG_MS0_PARAMETERS + 0:
+			s = " MS0_P3[15:8] " + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 1:
+			s = " MS0_P3[ 7:0] " + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 2:
+			s = " R0_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS0_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS0_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 3:
+			s = " MS0_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 4:
+			s = " MS0_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 5:
+			s  = " MS0_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MS0_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 6:
+			s = " MS0_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS0_PARAMETERS + 7:
+			s = " MS0_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS1_PARAMETERS + 0:
+			s = " MS1_P3[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 1:
+			s = " MS1_P3[ 7:0]-" + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 2:
+			s = " R1_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS1_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS1_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 3:
+			s = " MS1_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 4:
+			s = " MS1_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 5:
+			s  = " MS1_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MS1_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 6:
+			s = " MS1_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS1_PARAMETERS + 7:
+			s = " MS1_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS2_PARAMETERS + 0:
+			s = " MS2_P3[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 1:
+			s = " MS2_P3[ 7:0]-" + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 2:
+			s = " R2_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS2_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS2_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 3:
+			s = " MS2_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 4:
+			s = " MS2_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 5:
+			s  = " MS2_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MS2_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 6:
+			s = " MS2_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS2_PARAMETERS + 7:
+			s = " MS2_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS3_PARAMETERS + 0:
+			s = " MS3_P3[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 1:
+			s = " MS3_P3[ 7:0]-" + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 2:
+			s = " R3_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS3_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS3_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 3:
+			s = " MS3_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 4:
+			s = " MS3_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 5:
+			s  = " MS3_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MS3_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 6:
+			s = " MS3_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS3_PARAMETERS + 7:
+			s = " MS3_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS4_PARAMETERS + 0:
+			s = " MS4_P3[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 1:
+			s = " MS4_P3[ 7:0]-" + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 2:
+			s = " R4_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS4_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS4_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 3:
+			s = " MS4_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 4:
+			s = " MS4_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 5:
+			s  = " MS4_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += "  MS4_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 6:
+			s = " MS4_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS4_PARAMETERS + 7:
+			s = " MS4_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS5_PARAMETERS + 0:
+			s = " MS5_P3[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 1:
+			s = " MS5_P3[ 7:0]-" + QString::number((uint32_t)value << 0);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 2:
+			s = " R5_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+
+			s += "  MS5_DIVBY4-";
+			switch ((value >> 2) & 0x03)
+			{
+				case 0: s += "DIV-N"; break;
+				case 1: s += "?????"; break;
+				case 2: s += "?????"; break;
+				case 3: s += "DIV-4"; break;
+			}
+
+			s += "  MS5_P1[17:16]-" + QString::number((uint32_t)(value & 0x03) << 16);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 3:
+			s = " MS5_P1[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 4:
+			s = " MS5_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 5:
+			s  = " MS5_P3[19:16]-" + QString::number((uint32_t)((value >> 4) & 0x0f) << 16);
+			s += " MS5_P2[19:16]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 16);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 6:
+			s = " MS5_P2[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_MS5_PARAMETERS + 7:
+			s = " MS5_P2[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS6_PARAMETERS:
+			s = " MS6_P1[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS7_PARAMETERS:
+			s = " MS7_P1[ 7:0]-" + QString::number(value);
+			break;
+
+		case SI5351_REG_MS67_OUTPUT_DIVIDER:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  R7_DIV[2:0]-" + QString::number(1u << ((value >> 4) & 0x07));
+			s += (value & 0x08) ? "  RESERVED"   : "  reserved";
+			s += "  R6_DIV[2:0]-" + QString::number(1u << ((value >> 0) & 0x07));
+			break;
+
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 0:
+			s  = (value & 0x80) ? " SSC_EN"   : " ssc_en";
+			s += "  SSDN_P2[14:8]-" + QString::number((uint32_t)(value & 0x7f) << 8);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 1:
+			s = " SSDN_P2[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 2:
+			s  = (value & 0x80) ? " SSC_MODE-CENTER"   : " ssc_mode-DOWN";
+			s += "  SSDN_P3[14:8]-" + QString::number((uint32_t)(value & 0x7f) << 8);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 3:
+			s = " SSDN_P3[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 4:
+			s = " SSDN_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 5:
+			s  =  " SSUDP[11:8]-"   + QString::number((uint32_t)((value >> 4) & 0x0f) << 8);
+			s += "  SSDN_P1[11:8]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 8);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 6:
+			s  = " SSUDP[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 7:
+			s  = " SSUP_P2[14:8]-" + QString::number((uint32_t)(value & 0x7f) << 8);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 8:
+			s  = " SSUP_P2[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 9:
+			s  = " SSUP_P3[14:8]-" + QString::number((uint32_t)(value & 0x7f) << 8);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 10:
+			s  = " SSUP_P3[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 11:
+			s  = " SSUP_P1[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 12:
+			s  =  " SS_NCLK[ 3:0]-" + QString::number((uint32_t)((value >> 4) & 0x0f));
+			s += "  SSUP_P1[11:8]-" + QString::number((uint32_t)((value >> 0) & 0x0f) << 8);
+			break;
+
+		case SI5351_REG_VCXO_PARAMTERS + 0:
+			s  = " VCXO_Param[ 7:0]-" + QString::number(value);
+			break;
+		case SI5351_REG_VCXO_PARAMTERS + 1:
+			s  = " VCXO_Param[15:8]-" + QString::number((uint32_t)value << 8);
+			break;
+		case SI5351_REG_VCXO_PARAMTERS + 2:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += (value & 0x40) ? " RESERVED"   : " reserved";
+			s += "  VCXO_Param[21:16]-" + QString::number((uint32_t)(value & 0x3f) << 16);
+			break;
+
+		case SI5351_REG_CLK0_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK0_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+		case SI5351_REG_CLK1_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK1_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+		case SI5351_REG_CLK2_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK2_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+		case SI5351_REG_CLK3_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK3_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+		case SI5351_REG_CLK4_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK4_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+		case SI5351_REG_CLK5_INITIAL_PHASE_OFFSET:
+			s  = (value & 0x80) ? " RESERVED"   : " reserved";
+			s += "  CLK5_PHOFF[6:0]-" + QString::number(value & 0x7f);
+			break;
+
+		case SI5351_REG_PLL_RESET:
+			s  = (value & 0x80) ?  " PLLB_RST" : " pllb_rst";
+			s += (value & 0x40) ? "  RESERVED" : "  reserved";
+			s += (value & 0x20) ? "  PLLA_RST" : "  plla_rst";
+			s += (value & 0x10) ? "  RESERVED" : "  reserved";
+			s += (value & 0x08) ? "  RESERVED" : "  reserved";
+			s += (value & 0x04) ? "  RESERVED" : "  reserved";
+			s += (value & 0x02) ? "  RESERVED" : "  reserved";
+			s += (value & 0x01) ? "  RESERVED" : "  reserved";
+			break;
+		case SI5351_REG_CRYSTAL_INTERNAL_LOAD_CAPACITANCE:
+			s = " XTAL_CL[1:0]-";
+			switch ((value >> 6) & 0x03)
+			{
+				case 0: s += "RES'D"; break;
+				case 1: s += "6pF  "; break;
+				case 2: s += "8pF  "; break;
+				case 3: s += "10pF "; break;
+			}
+			s += "  RESERVED-" + QString("%1").arg(value & 0x3f, 6, 2, QChar('0'));
+			break;
+		case SI5351_REG_FANOUT_ENABLE:
+			s  = (value & 0x80) ? " CLKIN_FANOUT_EN" : " clkin_fanout_en";
+			s += (value & 0x40) ? "  XO_FANOUT_EN"   : "  xo_fanout_en";
+			s += (value & 0x20) ? "  RESERVED"       : "  reserved";
+			s += (value & 0x40) ? "  MS_FANOUT_EN"   : "  ms_fanout_en";
+			s += "  RESERVED-" + QString("%1").arg(value & 0x0f, 4, 2, QChar('0'));
+			break;
+
+		default:
+			s = "Unknown register";
+			break;
+	}
+
+	return s;
+}
+
+// ****************************************************************
+// (addr, value) -> description cache
+//
+// filled lazily on first use, or all at once by the warm-up thread
+
+static QMutex  reg_desc_mutex;
+static QString reg_desc_cache[256][256];
+static bool    reg_desc_valid[256][256];
+
+QString si5351_reg_description_cached(const int addr, const uint8_t value)
+{
+	if (addr < 0 || addr >= 256)
+		return si5351_reg_description(addr, value);
+
+	{
+		QMutexLocker locker(&reg_desc_mutex);
+		if (reg_desc_valid[addr][value])
+			return reg_desc_cache[addr][value];
+	}
+
+	// build it outside the lock, another thread building the same entry at the same time is harmless
+	const QString s = si5351_reg_description(addr, value);
+
+	QMutexLocker locker(&reg_desc_mutex);
+	reg_desc_cache[addr][value] = s;
+	reg_desc_valid[addr][value] = true;
+
+	return s;
+}
+
+// ****************************************************************
+
+void RegDescriptionWarmThread::run()
+{	// fill the cache for every value of every known register
+	for (unsigned int i = 0; i < si5351_reg_list_count && !isInterruptionRequested(); i++)
+		for (int value = 0; value < 256; value++)
+			si5351_reg_description_cached(si5351_reg_list[i].addr, value);
+}
@@ -0,0 +1,29 @@
+// Si5351 I2C data decoder
+//
+// Register setting descriptions and the shared (addr, value) description cache
+
+#ifndef REGDESC_H
+#define REGDESC_H
+
+#include <QString>
+#include <QThread>
+
+#include <stdint.h>
+
+// build the description of a register value (uncached)
+QString si5351_reg_description(const int addr, const uint8_t value);
+
+// same as above but via the cache shared by everything that displays/exports register descriptions
+QString si5351_reg_description_cached(const int addr, const uint8_t value);
+
+// fills the description cache in the background so the first register table updates are lookups only
+class RegDescriptionWarmThread : public QThread
+{
+public:
+	RegDescriptionWarmThread(QObject *parent = nullptr) : QThread(parent) {}
+
+protected:
+	void run() override;
+};
+
+#endif
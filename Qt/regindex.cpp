@@ -0,0 +1,232 @@
+// Si5351 I2C data decoder
+//
+// Inverted index of a capture .. for each register, the lines that wrote it
+
+#include <algorithm>
+
+#include "regindex.h"
+
+// ****************************************************************
+
+static void reg_index_put_varint(std::vector <uint8_t> &buf, uint32_t v)
+{
+	while (v >= 0x80)
+	{
+		buf.push_back((uint8_t)(v | 0x80));
+		v >>= 7;
+	}
+	buf.push_back((uint8_t)v);
+}
+
+static uint32_t reg_index_get_varint(const uint8_t *&p)
+{
+	uint32_t v     = 0;
+	int      shift = 0;
+	while (*p & 0x80)
+	{
+		v |= (uint32_t)(*p++ & 0x7f) << shift;
+		shift += 7;
+	}
+	v |= (uint32_t)(*p++) << shift;
+	return v;
+}
+
+// ****************************************************************
+
+uint32_t t_reg_postings::lineAt(const uint32_t i) const
+{
+	const uint32_t k    = i / REG_INDEX_SKIP;
+	uint32_t       line = skip_line[k];
+	const uint8_t *p    = deltas.data() + skip_offset[k];
+
+	for (uint32_t n = k * REG_INDEX_SKIP; n < i; n++)
+		line += reg_index_get_varint(p);
+
+	return line;
+}
+
+uint32_t t_reg_postings::lowerBound(const uint32_t line) const
+{
+	if (count == 0 || skip_line.empty() || line <= skip_line[0])
+		return 0;
+	if (line > last_line)
+		return count;
+
+	// the last skip block starting before 'line', then walk it
+	const uint32_t k = (uint32_t)(std::lower_bound(skip_line.begin(), skip_line.end(), line) - skip_line.begin()) - 1;
+
+	uint32_t       i = k * REG_INDEX_SKIP;
+	uint32_t       l = skip_line[k];
+	const uint8_t *p = deltas.data() + skip_offset[k];
+
+	while (l < line)
+	{
+		l += reg_index_get_varint(p);
+		i++;
+	}
+
+	return i;
+}
+
+// ****************************************************************
+
+void t_reg_index::clear()
+{
+	for (int addr = 0; addr < 256; addr++)
+	{
+		t_reg_postings &post = reg[addr];
+		post.count     = 0;
+		post.last_line = 0;
+		post.deltas.clear();
+		post.skip_line.clear();
+		post.skip_offset.clear();
+		post.values.clear();
+		post.value_order.clear();
+		post.value_start.clear();
+	}
+}
+
+void t_reg_index::build(const t_capture &capture)
+{
+	clear();
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		int addr = (size > 0) ? values[0] : 256;
+		for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+		{
+			t_reg_postings &post = reg[addr];
+
+			if ((post.count % REG_INDEX_SKIP) == 0)
+			{	// skip entry .. the delta is still written so every posting decodes the same way
+				post.skip_line.push_back(i);
+				reg_index_put_varint(post.deltas, (post.count > 0) ? i - post.last_line : i);
+				post.skip_offset.push_back((uint32_t)post.deltas.size());
+			}
+			else
+				reg_index_put_varint(post.deltas, i - post.last_line);
+
+			post.values.push_back(values[k]);
+			post.last_line = i;
+			post.count++;
+		}
+	}
+
+	// value ordering .. a counting sort per register
+	for (int addr = 0; addr < 256; addr++)
+	{
+		t_reg_postings &post = reg[addr];
+		if (post.count == 0)
+			continue;
+
+		post.value_start.assign(257, 0);
+		for (uint32_t i = 0; i < post.count; i++)
+			post.value_start[post.values[i] + 1]++;
+		for (int v = 0; v < 256; v++)
+			post.value_start[v + 1] += post.value_start[v];
+
+		std::vector <uint32_t> fill(post.value_start.begin(), post.value_start.end() - 1);
+		post.value_order.resize(post.count);
+		for (uint32_t i = 0; i < post.count; i++)
+			post.value_order[fill[post.values[i]]++] = i;
+
+		post.deltas.shrink_to_fit();
+	}
+}
+
+unsigned int t_reg_index::valueWrites(const int addr, const uint8_t value) const
+{
+	if (addr < 0 || addr >= 256 || reg[addr].count == 0 || reg[addr].value_start.empty())
+		return 0;
+	return reg[addr].value_start[value + 1] - reg[addr].value_start[value];
+}
+
+int t_reg_index::nextWrite(const int addr, const int line) const
+{
+	if (addr < 0 || addr >= 256)
+		return -1;
+
+	const t_reg_postings &post = reg[addr];
+	const uint32_t        i    = post.lowerBound((line < 0) ? 0 : line + 1);
+	return (i < post.count) ? (int)post.lineAt(i) : -1;
+}
+
+int t_reg_index::prevWrite(const int addr, const int line) const
+{
+	if (addr < 0 || addr >= 256 || line <= 0)
+		return -1;
+
+	const t_reg_postings &post = reg[addr];
+	const uint32_t        i    = post.lowerBound(line);
+	return (i > 0) ? (int)post.lineAt(i - 1) : -1;
+}
+
+int t_reg_index::lastWrite(const int addr, const int line, uint8_t *value) const
+{
+	if (addr < 0 || addr >= 256 || line < 0)
+		return -1;
+
+	const t_reg_postings &post = reg[addr];
+	const uint32_t        i    = post.lowerBound(line + 1);
+	if (i == 0)
+		return -1;
+
+	if (value)
+		*value = post.values[i - 1];
+	return (int)post.lineAt(i - 1);
+}
+
+int t_reg_index::nextValueWrite(const int addr, const uint8_t value, const int line) const
+{
+	if (valueWrites(addr, value) == 0)
+		return -1;
+
+	const t_reg_postings &post  = reg[addr];
+	const uint32_t        first = post.lowerBound((line < 0) ? 0 : line + 1);
+
+	// the value's postings are in posting order, so a binary search on the posting number
+	const uint32_t *begin = post.value_order.data() + post.value_start[value];
+	const uint32_t *end   = post.value_order.data() + post.value_start[value + 1];
+	const uint32_t *it    = std::lower_bound(begin, end, first);
+
+	return (it < end) ? (int)post.lineAt(*it) : -1;
+}
+
+int t_reg_index::prevValueWrite(const int addr, const uint8_t value, const int line) const
+{
+	if (line <= 0 || valueWrites(addr, value) == 0)
+		return -1;
+
+	const t_reg_postings &post  = reg[addr];
+	const uint32_t        first = post.lowerBound(line);
+
+	const uint32_t *begin = post.value_order.data() + post.value_start[value];
+	const uint32_t *end   = post.value_order.data() + post.value_start[value + 1];
+	const uint32_t *it    = std::lower_bound(begin, end, first);
+
+	return (it > begin) ? (int)post.lineAt(*(it - 1)) : -1;
+}
+
+void t_reg_index::valueWriteLines(const int addr, const uint8_t value, std::vector <uint32_t> &lines) const
+{
+	lines.clear();
+
+	if (valueWrites(addr, value) == 0)
+		return;
+
+	// one sequential decode of the register's list
+	const t_reg_postings &post = reg[addr];
+	const uint8_t        *p    = post.deltas.data();
+	uint32_t              line = 0;
+
+	lines.reserve(valueWrites(addr, value));
+	for (uint32_t i = 0; i < post.count; i++)
+	{
+		line += reg_index_get_varint(p);
+		if (post.values[i] == value)
+			lines.push_back(line);
+	}
+}
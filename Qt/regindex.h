@@ -0,0 +1,68 @@
+// Si5351 I2C data decoder
+//
+// Inverted index of a capture .. for each register, the lines that wrote it
+
+#ifndef REGINDEX_H
+#define REGINDEX_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+
+#define REG_INDEX_SKIP      64	// postings between skip entries
+
+// the posting list of one register
+//
+// the line numbers are stored as LEB128 varint deltas, a skip entry every REG_INDEX_SKIP postings
+// gives random access in O(log n + REG_INDEX_SKIP)
+struct t_reg_postings
+{
+	uint32_t               count     = 0;
+	uint32_t               last_line = 0;
+	std::vector <uint8_t>  deltas;        // line deltas (1st one is the line itself)
+	std::vector <uint32_t> skip_line;     // line of posting n * REG_INDEX_SKIP
+	std::vector <uint32_t> skip_offset;   // offset in 'deltas' just after that posting
+	std::vector <uint8_t>  values;        // the value written by each posting
+
+	// posting numbers sorted by the value written (posting order kept within a value),
+	// the postings that wrote 'v' are value_order[value_start[v] .. value_start[v + 1] - 1]
+	std::vector <uint32_t> value_order;
+	std::vector <uint32_t> value_start;
+
+	// line of the i'th posting
+	uint32_t lineAt(const uint32_t i) const;
+
+	// number of the first posting on or after 'line'
+	uint32_t lowerBound(const uint32_t line) const;
+};
+
+struct t_reg_index
+{
+	t_reg_postings reg[256];
+
+	void clear();
+
+	void build(const t_capture &capture);
+
+	unsigned int writes(const int addr) const { return (addr >= 0 && addr < 256) ? reg[addr].count : 0; }
+
+	// writes of 'value' to the register
+	unsigned int valueWrites(const int addr, const uint8_t value) const;
+
+	// the next/previous line after/before 'line' that wrote the register, -1 if none
+	int nextWrite(const int addr, const int line) const;
+	int prevWrite(const int addr, const int line) const;
+
+	// the last line up to and including 'line' that wrote the register, -1 if none
+	int lastWrite(const int addr, const int line, uint8_t *value = nullptr) const;
+
+	// the next/previous line after/before 'line' that wrote 'value' to the register, -1 if none
+	int nextValueWrite(const int addr, const uint8_t value, const int line) const;
+	int prevValueWrite(const int addr, const uint8_t value, const int line) const;
+
+	// every line that wrote 'value' to the register
+	void valueWriteLines(const int addr, const uint8_t value, std::vector <uint32_t> &lines) const;
+};
+
+#endif
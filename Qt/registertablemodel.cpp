@@ -0,0 +1,141 @@
+// Si5351 I2C data decoder
+//
+// Register table model over the live 256 byte register image
+
+#include <QApplication>
+#include <QPalette>
+
+#include <string.h>
+
+#include "si5351.h"
+#include "regdesc.h"
+#include "registertablemodel.h"
+
+RegisterTableModel::RegisterTableModel(QObject *parent) :
+	QAbstractTableModel(parent)
+{
+	memset(&m_reg_values[0], 0, sizeof(m_reg_values));
+	memset(&m_updated[0], 0, sizeof(m_updated));
+
+	for (unsigned int i = 0; i < si5351_reg_list_count; i++)
+		m_reg_values[si5351_reg_list[i].addr] = si5351_reg_list[i].reset_value;
+}
+
+int RegisterTableModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : (int)si5351_reg_list_count;
+}
+
+int RegisterTableModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : REG_TABLE_COL_COUNT;
+}
+
+Qt::ItemFlags RegisterTableModel::flags(const QModelIndex &index) const
+{
+	Q_UNUSED(index);
+
+	return Qt::ItemIsEnabled;
+}
+
+QVariant RegisterTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch (section)
+	{
+		case REG_TABLE_COL_ADDR:     return QString("Reg");
+		case REG_TABLE_COL_NAME:     return QString("Reg Name");
+		case REG_TABLE_COL_VALUE:    return QString("Value  ");
+		case REG_TABLE_COL_SETTINGS: return QString("Settings");
+	}
+
+	return QVariant();
+}
+
+QVariant RegisterTableModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() < 0 || index.row() >= (int)si5351_reg_list_count)
+		return QVariant();
+
+	const int     addr    = si5351_reg_list[index.row()].addr;
+	const uint8_t value   = m_reg_values[addr];
+	const bool    updated = m_updated[addr];
+
+	switch (role)
+	{
+		case Qt::DisplayRole:
+		{
+			QString s;
+			switch (index.column())
+			{
+				case REG_TABLE_COL_ADDR:
+					s.sprintf("%4d  ", addr);
+					return s;
+				case REG_TABLE_COL_NAME:
+					return QString(si5351_reg_list[index.row()].name);
+				case REG_TABLE_COL_VALUE:
+					s.sprintf("%02X", value);
+					s += "  " + QString("%1").arg(value, 8, 2, QChar('0'));
+					if (updated)
+						s = "* " + s;  // highlight the updated registers
+					return s;
+				case REG_TABLE_COL_SETTINGS:
+					return si5351_reg_description_cached(addr, value);
+			}
+			break;
+		}
+
+		case Qt::TextAlignmentRole:
+			if (index.column() == REG_TABLE_COL_ADDR || index.column() == REG_TABLE_COL_VALUE)
+				return (int)(Qt::AlignRight | Qt::AlignVCenter);
+			return (int)(Qt::AlignLeft | Qt::AlignVCenter);
+
+		// highlight the updated registers
+		case Qt::BackgroundRole:
+			if (updated)
+				return QApplication::palette().brush(QPalette::Highlight);
+			break;
+		case Qt::ForegroundRole:
+			if (updated)
+				return QApplication::palette().brush(QPalette::HighlightedText);
+			break;
+
+		case UpdatedRole:
+			return updated;
+	}
+
+	return QVariant();
+}
+
+void RegisterTableModel::setRegisters(const uint8_t *reg_values, const bool *updated_regs)
+{
+	// signal each run of changed rows as one range
+	int first = -1;
+
+	for (int row = 0; row <= (int)si5351_reg_list_count; row++)
+	{
+		bool changed = false;
+
+		if (row < (int)si5351_reg_list_count)
+		{
+			const int addr = si5351_reg_list[row].addr;
+			if (m_reg_values[addr] != reg_values[addr] || m_updated[addr] != updated_regs[addr])
+			{
+				m_reg_values[addr] = reg_values[addr];
+				m_updated[addr]    = updated_regs[addr];
+				changed = true;
+			}
+		}
+
+		if (changed && first < 0)
+			first = row;
+		else
+		if (!changed && first >= 0)
+		{
+			emit dataChanged(index(first, REG_TABLE_COL_ADDR), index(row - 1, REG_TABLE_COL_COUNT - 1));
+			first = -1;
+		}
+	}
+}
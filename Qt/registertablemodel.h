@@ -0,0 +1,42 @@
+// Si5351 I2C data decoder
+//
+// Register table model over the live 256 byte register image
+
+#ifndef REGISTERTABLEMODEL_H
+#define REGISTERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+
+#include <stdint.h>
+
+#define REG_TABLE_COL_ADDR          0
+#define REG_TABLE_COL_NAME          1
+#define REG_TABLE_COL_VALUE         2
+#define REG_TABLE_COL_SETTINGS      3
+#define REG_TABLE_COL_COUNT         4
+
+class RegisterTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	// true if the register was written by the selected line
+	static const int UpdatedRole = Qt::UserRole + 0;
+
+	RegisterTableModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+	// update the register image, only the rows that actually changed are signalled
+	void setRegisters(const uint8_t *reg_values, const bool *updated_regs);
+
+private:
+	uint8_t m_reg_values[256];
+	bool    m_updated[256];
+};
+
+#endif
@@ -0,0 +1,212 @@
+// Si5351 I2C data decoder
+//
+// Planner <-> decoder round trip check and throughput bench
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include "si5351.h"
+#include "selftest.h"
+
+// ****************************************************************
+
+struct t_selftest_output
+{
+	unsigned int clk;
+	unsigned int pll;
+	uint32_t     freq_Hz;
+};
+
+static double selftest_secs(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration <double> (std::chrono::steady_clock::now() - start).count();
+}
+
+// count a failure, describing the first few
+static void selftest_fail(t_selftest_result &result, const char *format, ...)
+{
+	if (result.failures++ >= SELFTEST_MAX_FAILURES)
+		return;
+
+	char s[192];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(s, sizeof(s), format, args);
+	va_end(args);
+
+	result.failure_text += s;
+}
+
+bool selftest_round_trip(const t_selftest_params &params, t_selftest_result &result)
+{
+	result = t_selftest_result();
+
+	if (params.ref_Hz == 0 || params.plans == 0)
+		return false;
+
+	// **********
+	// the random requests .. made up front so only the planning is timed
+
+	std::mt19937 rng(params.seed);
+	std::uniform_real_distribution <double> log_Hz(log((double)SELFTEST_MIN_HZ), log((double)SELFTEST_MAX_HZ));
+	std::uniform_int_distribution <unsigned int> any_clk(0, PLL_PLAN_OUTPUTS - 1);
+	std::uniform_int_distribution <unsigned int> any_pll(0, 1);
+
+	std::vector <t_selftest_output> requests((size_t)params.plans * SELFTEST_OUTPUTS_PER_PLAN);
+	for (unsigned int i = 0; i < params.plans; i++)
+	{
+		t_selftest_output *out = &requests[(size_t)i * SELFTEST_OUTPUTS_PER_PLAN];
+
+		uint8_t used = 0;
+		for (unsigned int k = 0; k < SELFTEST_OUTPUTS_PER_PLAN; k++)
+		{
+			unsigned int clk;
+			do
+				clk = any_clk(rng);
+			while (used & (1u << clk));
+			used |= 1u << clk;
+
+			out[k].clk     = clk;
+			out[k].pll     = (k == 0) ? 0 : any_pll(rng);
+			out[k].freq_Hz = (uint32_t)exp(log_Hz(rng));
+		}
+	}
+
+	// **********
+	// plan
+
+	std::vector <t_pll_plan> plans(params.plans);
+	std::vector <uint32_t>   planned_Hz(requests.size());    // what the planner returned for each request
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < params.plans; i++)
+	{
+		const t_selftest_output *out = &requests[(size_t)i * SELFTEST_OUTPUTS_PER_PLAN];
+		uint32_t                *got = &planned_Hz[(size_t)i * SELFTEST_OUTPUTS_PER_PLAN];
+		t_pll_plan &plan = plans[i];
+
+		pll_plan_init(plan, params.ref_Hz, params.frac_mode);
+		for (unsigned int k = 0; k < SELFTEST_OUTPUTS_PER_PLAN; k++)
+		{	// the 1st output on each PLL sets its VCO frequency
+			if (plan.used_plls & (1u << out[k].pll))
+				got[k] = pll_plan_output_from_pll(plan, out[k].clk, out[k].pll, out[k].freq_Hz);
+			else
+				got[k] = pll_plan_output(plan, out[k].clk, out[k].pll, out[k].freq_Hz);
+		}
+	}
+
+	result.plan_secs = selftest_secs(start);
+	result.plans     = params.plans;
+
+	// **********
+	// decode
+
+	std::vector <t_si5351_freqs> decoded(params.plans);
+
+	uint8_t reset_regs[256];
+	si5351_reset_regs(reset_regs);
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < params.plans; i++)
+	{	// the plan's I2C burst written onto the reset state the way capture_replay() does
+		uint8_t buffer[PLL_PLAN_BUFFER_SIZE];
+		uint8_t regs[256];
+		memcpy(regs, reset_regs, sizeof(regs));
+
+		const unsigned int size = pll_plan_buffer(plans[i], buffer);
+		int addr = buffer[0];
+		for (unsigned int k = 1; k < size && addr < 256; k++)
+			regs[addr++] = buffer[k];
+
+		si5351_freqs_reset(&decoded[i]);
+		si5351_freqs_update(&decoded[i], regs, params.ref_Hz, SI5351_DEP_ALL);
+	}
+
+	result.decode_secs = selftest_secs(start);
+
+	// **********
+	// compare
+
+	for (unsigned int i = 0; i < params.plans; i++)
+	{
+		const t_selftest_output *out   = &requests[(size_t)i * SELFTEST_OUTPUTS_PER_PLAN];
+		const uint32_t          *got   = &planned_Hz[(size_t)i * SELFTEST_OUTPUTS_PER_PLAN];
+		const t_pll_plan        &plan  = plans[i];
+		const t_si5351_freqs    &freqs = decoded[i];
+
+		if (!pll_plan_valid(plan))
+		{
+			result.out_of_limits++;
+			selftest_fail(result, "plan %u outside the Si5351 limits\n", i);
+		}
+
+		// the burst has to leave the outputs the plan doesn't use off
+		for (unsigned int clk = 0; clk < PLL_PLAN_OUTPUTS; clk++)
+			if (!(plan.used_clks & (1u << clk)) && freqs.clk_Hz[clk] != 0.0)
+				selftest_fail(result, "plan %u CLK-%u not planned but decoded %0.6f Hz\n", i, clk, freqs.clk_Hz[clk]);
+
+		for (unsigned int k = 0; k < SELFTEST_OUTPUTS_PER_PLAN; k++)
+		{
+			const unsigned int clk  = out[k].clk;
+			const bool         used = (plan.used_clks & (1u << clk)) != 0;
+
+			if (got[k] == 0)
+			{	// the planner has to leave what it can't do out of the plan
+				result.unplannable++;
+				if (used)
+					selftest_fail(result, "plan %u CLK-%u want %u Hz, planner said it couldn't but planned it\n", i, clk, out[k].freq_Hz);
+				continue;
+			}
+
+			if (!used || got[k] != plan.clk_Hz[clk])
+			{
+				selftest_fail(result, "plan %u CLK-%u want %u Hz, planner returned %u Hz but planned %u Hz\n", i, clk, out[k].freq_Hz, got[k], used ? plan.clk_Hz[clk] : 0);
+				continue;
+			}
+
+			result.outputs++;
+
+			const t_pll_plan_ms &ms = plan.ms[clk];
+
+			const double exact_Hz = ms.want_Hz + (plan.clk_err_uHz[clk] * 1e-6);
+			const double err_diff = fabs(freqs.clk_Hz[clk] - exact_Hz);
+			const double clk_diff = fabs(freqs.clk_Hz[clk] - plan.clk_Hz[clk]);
+
+			if (result.max_err_diff_Hz < err_diff)
+				result.max_err_diff_Hz = err_diff;
+			if (result.max_clk_diff_Hz < clk_diff)
+				result.max_clk_diff_Hz = clk_diff;
+
+			// an integer only divider 'a' is at most a divider step from the one the request needs, so 1/a off at most
+			const bool   int_only = (clk >= 6 || ms.div_by_4 == 3);
+			const double max_rel  = ((int_only && ms.div.a > 0) ? 1.0 / ms.div.a : 0.0) + (SELFTEST_FRAC_TOL_PPM * 1e-6);
+			if (fabs(exact_Hz - out[k].freq_Hz) > out[k].freq_Hz * max_rel)
+			{
+				result.off_target++;
+				selftest_fail(result, "plan %u CLK-%u PLL-%c want %u Hz, planner %0.6f Hz, too far off\n", i, clk, 'A' + ms.pll, out[k].freq_Hz, exact_Hz);
+				continue;
+			}
+
+			if (err_diff <= SELFTEST_ERR_TOL_HZ && clk_diff <= SELFTEST_CLK_TOL_HZ)
+				continue;
+
+			selftest_fail(result, "plan %u CLK-%u PLL-%c want %u Hz, planner %u Hz (%0.6f Hz exact), decoded %0.6f Hz\n",
+				i,
+				clk,
+				'A' + ms.pll,
+				ms.want_Hz,
+				plan.clk_Hz[clk],
+				exact_Hz,
+				freqs.clk_Hz[clk]);
+		}
+	}
+
+	return result.failures == 0;
+}
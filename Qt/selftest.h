@@ -0,0 +1,60 @@
+// Si5351 I2C data decoder
+//
+// Planner <-> decoder round trip check and throughput bench
+//
+// random output frequencies are planned, each plan's I2C burst (pll_plan_buffer()) is written onto the reset register
+// image and decoded with the same register image decoder the GUI uses, and every output's decoded frequency has to
+// match what the planner said it achieved
+
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+#include <string>
+#include <stdint.h>
+
+#include "pllplan.h"
+
+#define SELFTEST_OUTPUTS_PER_PLAN   3           // the 1st sets the PLL, the others are on the same or the other PLL
+
+#define SELFTEST_MIN_HZ             2500        // random frequencies (log uniform)
+#define SELFTEST_MAX_HZ             200000000
+
+#define SELFTEST_ERR_TOL_HZ         1e-4        // planner's exact achieved frequency against the decoder's (double maths)
+#define SELFTEST_CLK_TOL_HZ         1.0         // planner's integer achieved frequency against the decoder's
+
+#define SELFTEST_FRAC_TOL_PPM       1.0         // achieved against requested, fractional multisynth .. an integer only
+                                                // divider (MS6/7, divide by 4) can be up to a divider step off
+
+#define SELFTEST_MAX_FAILURES       10          // failures described in the result
+
+struct t_selftest_params
+{
+	uint32_t     ref_Hz;
+	int          frac_mode;     // PLL_FRAC_xxx
+	unsigned int plans;
+	uint32_t     seed;
+};
+
+struct t_selftest_result
+{
+	unsigned int plans;
+	unsigned int outputs;           // planned outputs checked
+	unsigned int unplannable;       // outputs the planner said it couldn't do (and left out of the plan)
+	unsigned int out_of_limits;     // plans outside the Si5351 limits (failures)
+	unsigned int off_target;        // outputs further from the requested frequency than their divider allows (failures)
+	unsigned int failures;          // the above, outputs that decoded to something other than the planner said, and
+	                                // outputs the planner said it did but left out of the plan (or the other way round)
+
+	double max_err_diff_Hz;
+	double max_clk_diff_Hz;
+
+	double plan_secs;
+	double decode_secs;         // burst onto the reset image and decode
+
+	std::string failure_text;       // the first few failures, one per line
+};
+
+// returns true if every plan is within the limits and every output decoded to what the planner said, near enough to what was asked for
+bool selftest_round_trip(const t_selftest_params &params, t_selftest_result &result);
+
+#endif
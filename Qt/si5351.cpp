@@ -0,0 +1,416 @@
+// Si5351 I2C data decoder
+//
+// Si5351 register map, register dependency map and the register image decoder
+
+#include <string.h>
+
+#include "si5351.h"
+
+// ****************************************************************
+
+const t_si5351_reg_list si5351_reg_list[] =
+{
+	{SI5351_REG_DEVICE_STATUS                    , 0x00, "DEVICE STATUS                    "},
+	{SI5351_REG_INTERRUPT_STATUS_STICKY          , 0x00, "INTERRUPT STATUS STICKY          "},
+	{SI5351_REG_INTERRUPT_STATUS_MASK            , 0x00, "INTERRUPT STATUS MASK            "},
+
+	{SI5351_REG_OUTPUT_ENABLE_CONTROL            , 0x00, "OUTPUT ENABLE CONTROL            "},
+	{SI5351_REG_OEB_PIN_ENABLE_CONTROL           , 0x00, "OEB PIN ENABLE CONTROL           "},
+
+	{SI5351_REG_PLL_INPUT_SOURCE                 , 0x00, "PLL INPUT SOURCE                 "},
+
+	{SI5351_REG_CLK0_CONTROL                     , 0x00, "CLK 0 CONTROL                    "},
+	{SI5351_REG_CLK1_CONTROL                     , 0x00, "CLK 1 CONTROL                    "},
+	{SI5351_REG_CLK2_CONTROL                     , 0x00, "CLK 2 CONTROL                    "},
+	{SI5351_REG_CLK3_CONTROL                     , 0x00, "CLK 3 CONTROL                    "},
+	{SI5351_REG_CLK4_CONTROL                     , 0x00, "CLK 4 CONTROL                    "},
+	{SI5351_REG_CLK5_CONTROL                     , 0x00, "CLK 5 CONTROL                    "},
+	{SI5351_REG_CLK6_CONTROL                     , 0x00, "CLK 6 CONTROL                    "},
+	{SI5351_REG_CLK7_CONTROL                     , 0x00, "CLK 7 CONTROL                    "},
+
+	{SI5351_REG_CLK3_0_DISABLE_STATE             , 0x00, "CLK 3 to 0 DISABLE STATE         "},
+	{SI5351_REG_CLK7_4_DISABLE_STATE             , 0x00, "CLK 7 to 4 DISABLE STATE         "},
+
+	{SI5351_REG_PLLA_PARAMETERS + 0              , 0x00, "PLL A PARAMETERS 0               "},
+	{SI5351_REG_PLLA_PARAMETERS + 1              , 0x00, "PLL A PARAMETERS 1               "},
+	{SI5351_REG_PLLA_PARAMETERS + 2              , 0x00, "PLL A PARAMETERS 2               "},
+	{SI5351_REG_PLLA_PARAMETERS + 3              , 0x00, "PLL A PARAMETERS 3               "},
+	{SI5351_REG_PLLA_PARAMETERS + 4              , 0x00, "PLL A PARAMETERS 4               "},
+	{SI5351_REG_PLLA_PARAMETERS + 5              , 0x00, "PLL A PARAMETERS 5               "},
+	{SI5351_REG_PLLA_PARAMETERS + 6              , 0x00, "PLL A PARAMETERS 6               "},
+	{SI5351_REG_PLLA_PARAMETERS + 7              , 0x00, "PLL A PARAMETERS 7               "},
+
+	{SI5351_REG_PLLB_PARAMETERS + 0              , 0x00, "PLL B PARAMETERS 0               "},
+	{SI5351_REG_PLLB_PARAMETERS + 1              , 0x00, "PLL B PARAMETERS 1               "},
+	{SI5351_REG_PLLB_PARAMETERS + 2              , 0x00, "PLL B PARAMETERS 2               "},
+	{SI5351_REG_PLLB_PARAMETERS + 3              , 0x00, "PLL B PARAMETERS 3               "},
+	{SI5351_REG_PLLB_PARAMETERS + 4              , 0x00, "PLL B PARAMETERS 4               "},
+	{SI5351_REG_PLLB_PARAMETERS + 5              , 0x00, "PLL B PARAMETERS 5               "},
+	{SI5351_REG_PLLB_PARAMETERS + 6              , 0x00, "PLL B PARAMETERS 6               "},
+	{SI5351_REG_PLLB_PARAMETERS + 7              , 0x00, "PLL B PARAMETERS 7               "},
+
+	{SI5351_REG_MS0_PARAMETERS + 0               , 0x00, "MS 0 PARAMETERS 0                "},
+	{SI5351_REG_MS0_PARAMETERS + 1               , 0x00, "MS 0 PARAMETERS 1                "},
+	{SI5351_REG_MS0_PARAMETERS + 2               , 0x00, "MS 0 PARAMETERS 2                "},
+	{SI5351_REG_MS0_PARAMETERS + 3               , 0x00, "MS 0 PARAMETERS 3                "},
+	{SI5351_REG_MS0_PARAMETERS + 4               , 0x00, "MS 0 PARAMETERS 4                "},
+	{SI5351_REG_MS0_PARAMETERS + 5               , 0x00, "MS 0 PARAMETERS 5                "},
+	{SI5351_REG_MS0_PARAMETERS + 6               , 0x00, "MS 0 PARAMETERS 6                "},
+	{SI5351_REG_MS0_PARAMETERS + 7               , 0x00, "MS 0 PARAMETERS 7                "},
+
+	{SI5351_REG_MS1_PARAMETERS + 0               , 0x00, "MS 1 PARAMETERS 0                "},
+	{SI5351_REG_MS1_PARAMETERS + 1               , 0x00, "MS 1 PARAMETERS 1                "},
+	{SI5351_REG_MS1_PARAMETERS + 2               , 0x00, "MS 1 PARAMETERS 2                "},
+	{SI5351_REG_MS1_PARAMETERS + 3               , 0x00, "MS 1 PARAMETERS 3                "},
+	{SI5351_REG_MS1_PARAMETERS + 4               , 0x00, "MS 1 PARAMETERS 4                "},
+	{SI5351_REG_MS1_PARAMETERS + 5               , 0x00, "MS 1 PARAMETERS 5                "},
+	{SI5351_REG_MS1_PARAMETERS + 6               , 0x00, "MS 1 PARAMETERS 6                "},
+	{SI5351_REG_MS1_PARAMETERS + 7               , 0x00, "MS 1 PARAMETERS 7                "},
+
+	{SI5351_REG_MS2_PARAMETERS + 0               , 0x00, "MS 2 PARAMETERS 0                "},
+	{SI5351_REG_MS2_PARAMETERS + 1               , 0x00, "MS 2 PARAMETERS 1                "},
+	{SI5351_REG_MS2_PARAMETERS + 2               , 0x00, "MS 2 PARAMETERS 2                "},
+	{SI5351_REG_MS2_PARAMETERS + 3               , 0x00, "MS 2 PARAMETERS 3                "},
+	{SI5351_REG_MS2_PARAMETERS + 4               , 0x00, "MS 2 PARAMETERS 4                "},
+	{SI5351_REG_MS2_PARAMETERS + 5               , 0x00, "MS 2 PARAMETERS 5                "},
+	{SI5351_REG_MS2_PARAMETERS + 6               , 0x00, "MS 2 PARAMETERS 6                "},
+	{SI5351_REG_MS2_PARAMETERS + 7               , 0x00, "MS 2 PARAMETERS 7                "},
+
+	{SI5351_REG_MS3_PARAMETERS + 0               , 0x00, "MS 3 PARAMETERS 0                "},
+	{SI5351_REG_MS3_PARAMETERS + 1               , 0x00, "MS 3 PARAMETERS 1                "},
+	{SI5351_REG_MS3_PARAMETERS + 2               , 0x00, "MS 3 PARAMETERS 2                "},
+	{SI5351_REG_MS3_PARAMETERS + 3               , 0x00, "MS 3 PARAMETERS 3                "},
+	{SI5351_REG_MS3_PARAMETERS + 4               , 0x00, "MS 3 PARAMETERS 4                "},
+	{SI5351_REG_MS3_PARAMETERS + 5               , 0x00, "MS 3 PARAMETERS 5                "},
+	{SI5351_REG_MS3_PARAMETERS + 6               , 0x00, "MS 3 PARAMETERS 6                "},
+	{SI5351_REG_MS3_PARAMETERS + 7               , 0x00, "MS 3 PARAMETERS 7                "},
+
+	{SI5351_REG_MS4_PARAMETERS + 0               , 0x00, "MS 4 PARAMETERS 0                "},
+	{SI5351_REG_MS4_PARAMETERS + 1               , 0x00, "MS 4 PARAMETERS 1                "},
+	{SI5351_REG_MS4_PARAMETERS + 2               , 0x00, "MS 4 PARAMETERS 2                "},
+	{SI5351_REG_MS4_PARAMETERS + 3               , 0x00, "MS 4 PARAMETERS 3                "},
+	{SI5351_REG_MS4_PARAMETERS + 4               , 0x00, "MS 4 PARAMETERS 4                "},
+	{SI5351_REG_MS4_PARAMETERS + 5               , 0x00, "MS 4 PARAMETERS 5                "},
+	{SI5351_REG_MS4_PARAMETERS + 6               , 0x00, "MS 4 PARAMETERS 6                "},
+	{SI5351_REG_MS4_PARAMETERS + 7               , 0x00, "MS 4 PARAMETERS 7                "},
+
+	{SI5351_REG_MS5_PARAMETERS + 0               , 0x00, "MS 5 PARAMETERS 0                "},
+	{SI5351_REG_MS5_PARAMETERS + 1               , 0x00, "MS 5 PARAMETERS 1                "},
+	{SI5351_REG_MS5_PARAMETERS + 2               , 0x00, "MS 5 PARAMETERS 2                "},
+	{SI5351_REG_MS5_PARAMETERS + 3               , 0x00, "MS 5 PARAMETERS 3                "},
+	{SI5351_REG_MS5_PARAMETERS + 4               , 0x00, "MS 5 PARAMETERS 4                "},
+	{SI5351_REG_MS5_PARAMETERS + 5               , 0x00, "MS 5 PARAMETERS 5                "},
+	{SI5351_REG_MS5_PARAMETERS + 6               , 0x00, "MS 5 PARAMETERS 6                "},
+	{SI5351_REG_MS5_PARAMETERS + 7               , 0x00, "MS 5 PARAMETERS 7                "},
+
+	{SI5351_REG_MS6_PARAMETERS                   , 0x00, "MS 6 PARAMETERS                  "},
+
+	{SI5351_REG_MS7_PARAMETERS                   , 0x00, "MS 7 PARAMETERS                  "},
+
+	{SI5351_REG_MS67_OUTPUT_DIVIDER              , 0x00, "CLOCK 6 & 7 OUTPUT DIVIDER       "},
+
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 0   , 0x00, "SPREAD SPECTRUM PARAMETERS 0     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 1   , 0x00, "SPREAD SPECTRUM PARAMETERS 1     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 2   , 0x00, "SPREAD SPECTRUM PARAMETERS 2     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 3   , 0x00, "SPREAD SPECTRUM PARAMETERS 3     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 4   , 0x00, "SPREAD SPECTRUM PARAMETERS 4     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 5   , 0x00, "SPREAD SPECTRUM PARAMETERS 5     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 6   , 0x00, "SPREAD SPECTRUM PARAMETERS 6     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 7   , 0x00, "SPREAD SPECTRUM PARAMETERS 7     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 8   , 0x00, "SPREAD SPECTRUM PARAMETERS 8     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 9   , 0x00, "SPREAD SPECTRUM PARAMETERS 9     "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 10  , 0x00, "SPREAD SPECTRUM PARAMETERS 10    "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 11  , 0x00, "SPREAD SPECTRUM PARAMETERS 11    "},
+	{SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + 12  , 0x00, "SPREAD SPECTRUM PARAMETERS 12    "},
+
+	{SI5351_REG_VCXO_PARAMTERS + 0               , 0x00, "VCXO PARAMTER BITS  0 to  7"      },
+	{SI5351_REG_VCXO_PARAMTERS + 1               , 0x00, "VCXO PARAMTER BITS  8 to 15"      },
+	{SI5351_REG_VCXO_PARAMTERS + 2               , 0x00, "VCXO PARAMTER BITS 16 to 21"      },
+
+	{SI5351_REG_CLK0_INITIAL_PHASE_OFFSET        , 0x00, "CLK 0 INITIAL PHASE OFFSET       "},
+	{SI5351_REG_CLK1_INITIAL_PHASE_OFFSET        , 0x00, "CLK 1 INITIAL PHASE OFFSET       "},
+	{SI5351_REG_CLK2_INITIAL_PHASE_OFFSET        , 0x00, "CLK 2 INITIAL PHASE OFFSET       "},
+	{SI5351_REG_CLK3_INITIAL_PHASE_OFFSET        , 0x00, "CLK 3 INITIAL PHASE OFFSET       "},
+	{SI5351_REG_CLK4_INITIAL_PHASE_OFFSET        , 0x00, "CLK 4 INITIAL PHASE OFFSET       "},
+	{SI5351_REG_CLK5_INITIAL_PHASE_OFFSET        , 0x00, "CLK 5 INITIAL PHASE OFFSET       "},
+
+	{SI5351_REG_PLL_RESET                        , 0x00, "PLL RESET                        "},
+	{SI5351_REG_CRYSTAL_INTERNAL_LOAD_CAPACITANCE, 0xC0, "CRYSTAL INTERNAL LOAD CAPACITANCE"},
+	{SI5351_REG_FANOUT_ENABLE                    , 0x00, "FAN OUT ENABLE                   "}
+};
+
+const unsigned int si5351_reg_list_count = ARRAY_SIZE(si5351_reg_list);
+
+void si5351_reset_regs(uint8_t *reg_values)
+{
+	memset(reg_values, 0, 256);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(si5351_reg_list); i++)
+		reg_values[si5351_reg_list[i].addr] = si5351_reg_list[i].reset_value;
+}
+
+// ****************************************************************
+// register -> node dependency map
+
+typedef struct
+{
+	uint32_t mask[256];
+} t_si5351_reg_deps;
+
+static t_si5351_reg_deps si5351_build_reg_deps()
+{
+	t_si5351_reg_deps deps;
+
+	memset(&deps, 0, sizeof(deps));
+
+	deps.mask[SI5351_REG_OUTPUT_ENABLE_CONTROL]  = SI5351_DEP_ALL_CLK;
+	deps.mask[SI5351_REG_OEB_PIN_ENABLE_CONTROL] = SI5351_DEP_ALL_CLK;
+
+	// PLL source and CLKIN divider
+	deps.mask[SI5351_REG_PLL_INPUT_SOURCE] = SI5351_DEP_PLLA | SI5351_DEP_PLLB;
+
+	// CLK control .. MS source PLL, MS INT mode, CLK source, power down, drive strength, invert
+	for (int n = 0; n < 8; n++)
+		deps.mask[SI5351_REG_CLK0_CONTROL + n] = SI5351_DEP_MS(n) | SI5351_DEP_CLK(n);
+
+	// the PLL INT/FRAC display state is taken from the CLK-6/7 control registers
+	deps.mask[SI5351_REG_CLK6_CONTROL] |= SI5351_DEP_PLLA;
+	deps.mask[SI5351_REG_CLK7_CONTROL] |= SI5351_DEP_PLLB;
+
+	// disabled output states
+	deps.mask[SI5351_REG_CLK3_0_DISABLE_STATE] = SI5351_DEP_CLK(0) | SI5351_DEP_CLK(1) | SI5351_DEP_CLK(2) | SI5351_DEP_CLK(3);
+	deps.mask[SI5351_REG_CLK7_4_DISABLE_STATE] = SI5351_DEP_CLK(4) | SI5351_DEP_CLK(5) | SI5351_DEP_CLK(6) | SI5351_DEP_CLK(7);
+
+	for (int i = 0; i < 8; i++)
+	{
+		deps.mask[SI5351_REG_PLLA_PARAMETERS + i] = SI5351_DEP_PLLA;
+		deps.mask[SI5351_REG_PLLB_PARAMETERS + i] = SI5351_DEP_PLLB;
+	}
+
+	// MS-0 to MS-5 .. the 3rd register also holds the output R-divider
+	for (int n = 0; n < 6; n++)
+	{
+		for (int i = 0; i < 8; i++)
+			deps.mask[SI5351_REG_MS0_PARAMETERS + (8 * n) + i] = SI5351_DEP_MS(n);
+		deps.mask[SI5351_REG_MS0_PARAMETERS + (8 * n) + 2] |= SI5351_DEP_CLK(n);
+	}
+
+	deps.mask[SI5351_REG_MS6_PARAMETERS]     = SI5351_DEP_MS(6);
+	deps.mask[SI5351_REG_MS7_PARAMETERS]     = SI5351_DEP_MS(7);
+	deps.mask[SI5351_REG_MS67_OUTPUT_DIVIDER] = SI5351_DEP_CLK(6) | SI5351_DEP_CLK(7);
+
+	// spread spectrum modulates PLL-A, the VCXO pulls PLL-B
+	for (int i = 0; i < 13; i++)
+		deps.mask[SI5351_REG_SPREAD_SPECTRUM_PARAMETERS + i] = SI5351_DEP_PLLA;
+	for (int i = 0; i < 3; i++)
+		deps.mask[SI5351_REG_VCXO_PARAMTERS + i] = SI5351_DEP_PLLB;
+
+	for (int n = 0; n < 6; n++)
+		deps.mask[SI5351_REG_CLK0_INITIAL_PHASE_OFFSET + n] = SI5351_DEP_CLK(n);
+
+	// self clearing reset bits .. no effect on any frequency
+	deps.mask[SI5351_REG_PLL_RESET] = SI5351_DEP_PLL_RESET;
+
+	return deps;
+}
+
+uint32_t si5351_reg_deps(const int addr)
+{
+	static const t_si5351_reg_deps deps = si5351_build_reg_deps();
+
+	return (addr >= 0 && addr < (int)ARRAY_SIZE(deps.mask)) ? deps.mask[addr] : 0;
+}
+
+uint32_t si5351_dep_propagate(const uint8_t *regs, uint32_t dirty)
+{
+	// PLL -> MS
+	if (dirty & (SI5351_DEP_PLLA | SI5351_DEP_PLLB))
+	{
+		for (int n = 0; n < 8; n++)
+		{
+			const int pll = (regs[SI5351_REG_CLK0_CONTROL + n] & 0x20) ? 1 : 0;
+			if (dirty & SI5351_DEP_PLL(pll))
+				dirty |= SI5351_DEP_MS(n);
+		}
+	}
+
+	// MS -> CLK
+	if (dirty & SI5351_DEP_ALL_MS)
+	{
+		for (int n = 0; n < 8; n++)
+		{
+			const int src = (regs[SI5351_REG_CLK0_CONTROL + n] >> 2) & 0x03;
+			if (src == 3 && (dirty & SI5351_DEP_MS(n)))
+				dirty |= SI5351_DEP_CLK(n);
+			else
+			if (src == 2 && (dirty & SI5351_DEP_MS(n & 4)))	// MS-0 for CLK 1 to 3, MS-4 for CLK 5 to 7
+				dirty |= SI5351_DEP_CLK(n);
+		}
+	}
+
+	return dirty;
+}
+
+uint32_t si5351_regs_diff(const uint8_t *old_regs, const uint8_t *new_regs)
+{
+	uint32_t dirty = 0;
+	for (int addr = 0; addr < 256; addr++)
+		if (old_regs[addr] != new_regs[addr])
+			dirty |= si5351_reg_deps(addr);
+	return dirty;
+}
+
+// ****************************************************************
+// register image decoder
+
+void si5351_freqs_reset(t_si5351_freqs *freqs)
+{
+	memset(freqs, 0, sizeof(*freqs));
+}
+
+static double si5351_calc_pll_Hz(const uint8_t *regs, const double xtal_Hz, const int pll)
+{
+	const uint8_t *reg      = &regs[SI5351_REG_PLLA_PARAMETERS + (8 * pll)];
+	const uint32_t p1       = ((uint32_t)(reg[2] & 0x03) << 16) | ((uint32_t)reg[3] << 8) | ((uint32_t)reg[4] << 0);
+	const uint32_t p2       = ((uint32_t)(reg[5] & 0x0f) << 16) | ((uint32_t)reg[6] << 8) | ((uint32_t)reg[7] << 0);
+	const uint32_t p3       = ((uint32_t)(reg[5] & 0xf0) << 12) | ((uint32_t)reg[0] << 8) | ((uint32_t)reg[1] << 0);
+	const uint8_t clkin_div = (regs[SI5351_REG_PLL_INPUT_SOURCE] >> 6) & 0x03;
+	const bool    src       = (regs[SI5351_REG_PLL_INPUT_SOURCE] & (pll ? 0x80 : 0x40)) ? true : false;
+
+	if (p3 == 0)
+		return 0.0;
+
+	const double ref_Hz = (src) ? xtal_Hz / (1u << clkin_div) : xtal_Hz;	// CLKIN/XTAL
+	const double pll_Hz = ref_Hz * (((double)p1 * p3) + (512.0 * p3) + p2) / (128.0 * p3);
+
+	// extract spread spectrum data
+	//const bool   ss_enabled           = (m_si5351_reg_values[SI5351_REG_SPREAD_SPECTRUM_PARAMETERS_0] & 0x80) ? true : false;
+	//const bool   ss_center            = (m_si5351_reg_values[SI5351_REG_SPREAD_SPECTRUM_PARAMETERS_2] & 0x80) ? true : false;
+
+	// spread spectrum
+	// this affects PLL-A (not PLL-B)
+/*
+	if (ss_enabled)
+	{
+		reg = &m_si5351_reg_values[SI5351_REG_SPREAD_SPECTRUM_PARAMETERS_0];
+		const uint16_t ssdn_p1 = ((uint16_t)(reg[ 5] & 0x0f) << 8) | reg[ 4];
+		const uint16_t ssdn_p2 = ((uint16_t)(reg[ 0] & 0x7f) << 8) | reg[ 1];
+		const uint16_t ssdn_p3 = ((uint16_t)(reg[ 2] & 0x7f) << 8) | reg[ 3];
+		const uint16_t ssudp   = ((uint16_t)(reg[ 5] & 0xf0) << 4) | reg[ 6];
+		const uint16_t ssup_p1 = ((uint16_t)(reg[12] & 0x0f) << 8) | reg[11];
+		const uint16_t ssup_p2 = ((uint16_t)(reg[ 7] & 0x7f) << 8) | reg[ 8];
+		const uint16_t ssup_p3 = ((uint16_t)(reg[ 9] & 0x7f) << 8) | reg[10];
+		const uint8_t  ss_nclk = (reg[12] >> 4) & 0x0f;
+
+		if (ssudp > 0)
+		{
+			const double pfd_Hz = (pll_a_src) ? pll_ref_Hz / (1u << clkin_div) : pll_ref_Hz;	// CLKIN/XTAL
+			const double pll_div = (((double)plla_p1 * plla_p3) + (512.0 * plla_p3) + plla_p2) / (128.0 * plla_p3);	// a + (b / c)
+
+			if (ss_center)
+			{	// center spread
+				// +-0.1% to +-1.5 in steps of 0.1%
+				// spread spectrum rate 30kHz to 33kHz (typ 31.5kHz)
+
+				// TODO:
+
+			}
+			else
+			{	// down spread
+				// -0.1% to -2.5% in steps of 0.1%
+				// spread spectrum rate 30kHz to 33kHz (typ 31.5kHz)
+
+				// TODO:
+
+			}
+		}
+	}
+*/
+
+	// VCXO
+
+	//	reg = &m_si5351_reg_values[SI5351_REG_VCXO_PARAMTER_0];
+	//	const uint32_t vcxo = ((uint32_t)(reg[2] & 0x3f) << 16) | ((uint32_t)reg[1] << 8) | reg[0];
+	//
+	//	// TODO:
+
+	return pll_Hz;
+}
+
+static double si5351_calc_ms_Hz(const uint8_t *regs, const double *pll_Hz, const int ms)
+{
+	const double in_Hz = (regs[SI5351_REG_CLK0_CONTROL + ms] & 0x20) ? pll_Hz[1] : pll_Hz[0];
+
+	if (ms >= 6)
+	{	// multisynth 6-7: fOUT = fIN / P1
+		const uint8_t p1 = regs[SI5351_REG_MS6_PARAMETERS + (ms - 6)];
+		return (p1 > 0) ? in_Hz / p1 : 0.0;
+	}
+
+	const uint8_t *reg      = &regs[SI5351_REG_MS0_PARAMETERS + (8 * ms)];
+	const uint32_t p1       = ((uint32_t)(reg[2] & 0x03) << 16) | ((uint32_t)reg[3] << 8) | ((uint32_t)reg[4] << 0);
+	const uint32_t p2       = ((uint32_t)(reg[5] & 0x0f) << 16) | ((uint32_t)reg[6] << 8) | ((uint32_t)reg[7] << 0);
+	const uint32_t p3       = ((uint32_t)(reg[5] & 0xf0) << 12) | ((uint32_t)reg[0] << 8) | ((uint32_t)reg[1] << 0);
+	const uint8_t  div_by_4 = (reg[2] >> 2) & 0x03;
+
+	if (p3 == 0 && div_by_4 != 3)
+		return 0.0;
+
+	return (div_by_4 == 3) ? in_Hz / 4 : (128.0 * p3 * in_Hz) / (((double)p1 * p3) + p2 + (512.0 * p3));
+}
+
+static double si5351_calc_clk_Hz(const uint8_t *regs, const double xtal_Hz, const double *ms_Hz, const int clk)
+{
+	const uint8_t ctrl          = regs[SI5351_REG_CLK0_CONTROL + clk];
+	const int     src           = (ctrl >> 2) & 0x03;
+	const bool    powered_down  = (ctrl & 0x80) ? true : false;
+	const bool    enabled       = (regs[SI5351_REG_OEB_PIN_ENABLE_CONTROL] & (1u << clk)) ? true : (regs[SI5351_REG_OUTPUT_ENABLE_CONTROL] & (1u << clk)) ? false : true;
+	uint8_t       r_div;
+
+	if (clk < 6)
+		r_div = (regs[SI5351_REG_MS0_PARAMETERS + (8 * clk) + 2] >> 4) & 0x07;
+	else
+		r_div = (regs[SI5351_REG_MS67_OUTPUT_DIVIDER] >> ((clk == 7) ? 4 : 0)) & 0x07;
+
+	if (powered_down || !enabled)
+		return 0.0;
+
+	double Hz = 0.0;
+	switch (src)
+	{
+		case 0:	// XTAL
+			Hz = xtal_Hz;
+			break;
+		case 1:	// CLK-IN
+			Hz = xtal_Hz;
+			break;
+		case 2:	// MS0 (CLK 1 to 3) or MS4 (CLK 5 to 7), reserved for CLK 0 and 4
+			if ((clk & 3) != 0)
+				Hz = ms_Hz[clk & 4];
+			break;
+		case 3:	// own MS
+			Hz = ms_Hz[clk];
+			break;
+	}
+
+	return Hz / (1u << r_div);
+}
+
+uint32_t si5351_freqs_update(t_si5351_freqs *freqs, const uint8_t *regs, const double xtal_Hz, uint32_t dirty)
+{
+	dirty = si5351_dep_propagate(regs, dirty);
+
+	for (int n = 0; n < 2; n++)
+		if (dirty & SI5351_DEP_PLL(n))
+			freqs->pll_Hz[n] = si5351_calc_pll_Hz(regs, xtal_Hz, n);
+
+	for (int n = 0; n < 8; n++)
+		if (dirty & SI5351_DEP_MS(n))
+			freqs->ms_Hz[n] = si5351_calc_ms_Hz(regs, freqs->pll_Hz, n);
+
+	for (int n = 0; n < 8; n++)
+		if (dirty & SI5351_DEP_CLK(n))
+			freqs->clk_Hz[n] = si5351_calc_clk_Hz(regs, xtal_Hz, freqs->ms_Hz, n);
+
+	return dirty;
+}
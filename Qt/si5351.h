@@ -0,0 +1,126 @@
+// Si5351 I2C data decoder
+//
+// Si5351 register map, register dependency map and the register image decoder
+
+#ifndef SI5351_H
+#define SI5351_H
+
+#include <stdint.h>
+
+// ****************************************************************
+
+#define ARRAY_SIZE(array)       (sizeof(array) / sizeof(array[0]))
+#define SQR(x)                  ((x) * (x))
+#define IROUND(x)               ((int)floor((x) + 0.5))
+#define I64ROUND(x)             ((int64_t)floor((x) + 0.5))
+#define MIN(a, b)               (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)               (((a) > (b)) ? (a) : (b))
+#define ABS(x)                  (((x) >= 0) ? (x) : -(x))
+
+// ****************************************************************
+
+#define SI5351_XTAL_HZ                      27000000
+
+#define SI5351_PLL_VCO_MAX_HZ               900000000
+#define SI5351_PLL_VCO_MIN_HZ               600000000
+
+#define SI5351_MS_MAX_HZ                    235000000
+#define SI5351_MS_MIN_HZ                    500000
+
+#define SI5351_MS_DIVBY4_HZ                 150000000
+
+typedef struct
+{
+	int     addr;
+	uint8_t reset_value;
+	char    name[48];
+	//QString name;
+} t_si5351_reg_list;
+
+#define SI5351_REG_DEVICE_STATUS                      0
+#define SI5351_REG_INTERRUPT_STATUS_STICKY            1
+#define SI5351_REG_INTERRUPT_STATUS_MASK              2
+#define SI5351_REG_OUTPUT_ENABLE_CONTROL              3
+#define SI5351_REG_OEB_PIN_ENABLE_CONTROL             9
+#define SI5351_REG_PLL_INPUT_SOURCE                   15
+#define SI5351_REG_CLK0_CONTROL                       16
+#define SI5351_REG_CLK1_CONTROL                       17
+#define SI5351_REG_CLK2_CONTROL                       18
+#define SI5351_REG_CLK3_CONTROL                       19
+#define SI5351_REG_CLK4_CONTROL                       20
+#define SI5351_REG_CLK5_CONTROL                       21
+#define SI5351_REG_CLK6_CONTROL                       22
+#define SI5351_REG_CLK7_CONTROL                       23
+#define SI5351_REG_CLK3_0_DISABLE_STATE               24
+#define SI5351_REG_CLK7_4_DISABLE_STATE               25
+#define SI5351_REG_PLLA_PARAMETERS                    26	// 8 registers
+#define SI5351_REG_PLLB_PARAMETERS                    34	// 8 registers
+#define SI5351_REG_MS0_PARAMETERS                     42	// 8 registers
+#define SI5351_REG_MS1_PARAMETERS                     50	// 8 registers
+#define SI5351_REG_MS2_PARAMETERS                     58	// 8 registers
+#define SI5351_REG_MS3_PARAMETERS                     66	// 8 registers
+#define SI5351_REG_MS4_PARAMETERS                     74	// 8 registers
+#define SI5351_REG_MS5_PARAMETERS                     82	// 8 registers
+#define SI5351_REG_MS6_PARAMETERS                     90	// 1 register
+#define SI5351_REG_MS7_PARAMETERS                     91	// 1 register
+#define SI5351_REG_MS67_OUTPUT_DIVIDER                92	// 1 register
+#define SI5351_REG_SPREAD_SPECTRUM_PARAMETERS         149	// 13 registers
+#define SI5351_REG_VCXO_PARAMTERS                     162	// 3 registers
+#define SI5351_REG_CLK0_INITIAL_PHASE_OFFSET          165
+#define SI5351_REG_CLK1_INITIAL_PHASE_OFFSET          166
+#define SI5351_REG_CLK2_INITIAL_PHASE_OFFSET          167
+#define SI5351_REG_CLK3_INITIAL_PHASE_OFFSET          168
+#define SI5351_REG_CLK4_INITIAL_PHASE_OFFSET          169
+#define SI5351_REG_CLK5_INITIAL_PHASE_OFFSET          170
+#define SI5351_REG_PLL_RESET                          177
+#define SI5351_REG_CRYSTAL_INTERNAL_LOAD_CAPACITANCE  183
+#define SI5351_REG_FANOUT_ENABLE                      187
+
+extern const t_si5351_reg_list si5351_reg_list[];
+extern const unsigned int      si5351_reg_list_count;
+
+// set all the register values to their default reset states
+void si5351_reset_regs(uint8_t *reg_values);
+
+// ****************************************************************
+// register -> PLL/multisynth/output dependency nodes
+//
+// each register write only affects a few of these, so after a write only the
+// nodes marked dirty need re-evaluating
+
+#define SI5351_DEP_PLLA                 (1u << 0)             // PLL-A VCO frequency and state
+#define SI5351_DEP_PLLB                 (1u << 1)             // PLL-B VCO frequency and state
+#define SI5351_DEP_PLL_RESET            (1u << 2)             // PLL reset flags (display only)
+#define SI5351_DEP_MS(n)                (1u << (3 + (n)))     // multisynth 0 to 7 output frequency
+#define SI5351_DEP_CLK(n)               (1u << (11 + (n)))    // CLK 0 to 7 output state/frequency
+
+#define SI5351_DEP_PLL(n)               ((n) ? SI5351_DEP_PLLB : SI5351_DEP_PLLA)
+#define SI5351_DEP_ALL_MS               (0xffu << 3)
+#define SI5351_DEP_ALL_CLK              (0xffu << 11)
+#define SI5351_DEP_ALL                  ((1u << 19) - 1)
+
+// the nodes directly affected by a write to 'addr'
+uint32_t si5351_reg_deps(const int addr);
+
+// add the nodes that are fed from already dirty nodes (PLL -> MS -> CLK), this depends on the current CLK routing
+uint32_t si5351_dep_propagate(const uint8_t *regs, uint32_t dirty);
+
+// ****************************************************************
+// register image decoder
+
+typedef struct
+{
+	double pll_Hz[2];    // PLL-A/B VCO frequency
+	double ms_Hz[8];     // multisynth 0 to 7 output frequency (before the output R-divider)
+	double clk_Hz[8];    // CLK 0 to 7 output frequency (0 if powered down or disabled)
+} t_si5351_freqs;
+
+void si5351_freqs_reset(t_si5351_freqs *freqs);
+
+// re-evaluate only the 'dirty' nodes, returns the propagated dirty node mask
+uint32_t si5351_freqs_update(t_si5351_freqs *freqs, const uint8_t *regs, const double xtal_Hz, uint32_t dirty);
+
+// dirty node mask between two register images
+uint32_t si5351_regs_diff(const uint8_t *old_regs, const uint8_t *new_regs);
+
+#endif
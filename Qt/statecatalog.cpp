@@ -0,0 +1,100 @@
+// Si5351 I2C data decoder
+//
+// Catalog of the distinct register configurations a capture goes through
+
+#include <algorithm>
+
+#include "statecatalog.h"
+
+// ****************************************************************
+
+void t_state_catalog::clear()
+{
+	states.clear();
+	line_state.clear();
+	m_by_hash.clear();
+}
+
+void t_state_catalog::build(const t_capture &capture, const t_state_hashes &hashes)
+{
+	clear();
+
+	const unsigned int lines = capture.lines();
+	if (lines == 0 || hashes.line_hash.size() != lines)
+		return;
+
+	// ******************
+	// number the states in the order they're first reached .. the hashes sorted list gives each one's lines
+
+	line_state.assign(lines, 0);
+
+	std::vector < std::pair <uint32_t, uint32_t> > first;	// (first line, index into hashes.by_hash of the state's 1st entry)
+	first.reserve(hashes.distinct);
+	for (unsigned int i = 0; i < hashes.by_hash.size(); i++)
+		if (i == 0 || hashes.by_hash[i].first != hashes.by_hash[i - 1].first)
+			first.push_back(std::make_pair(hashes.by_hash[i].second, i));
+	std::sort(first.begin(), first.end());
+
+	states.resize(first.size());
+	m_by_hash.resize(first.size());
+
+	for (unsigned int s = 0; s < first.size(); s++)
+	{
+		t_state_entry &state = states[s];
+
+		unsigned int i = first[s].second;
+
+		state.hash       = hashes.by_hash[i].first;
+		state.count      = 0;
+		state.first_line = hashes.by_hash[i].second;
+		state.last_line  = state.first_line;
+
+		for ( ; i < hashes.by_hash.size() && hashes.by_hash[i].first == state.hash; i++)
+		{
+			line_state[hashes.by_hash[i].second] = s;
+			state.last_line = hashes.by_hash[i].second;
+			state.count++;
+		}
+
+		m_by_hash[s] = std::make_pair(state.hash, s);
+	}
+
+	std::sort(m_by_hash.begin(), m_by_hash.end());
+
+	// ******************
+	// one replay, the frequencies are evaluated when a state is first reached
+
+	uint8_t regs[256];
+	si5351_reset_regs(regs);
+
+	unsigned int next_state = 0;
+
+	for (unsigned int i = 0; i < lines && next_state < states.size(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		if (size > 0)
+		{
+			// clear the PLL self clearing bits
+			regs[SI5351_REG_PLL_RESET] &= 0x5f;
+
+			int addr = values[0];
+			for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+				regs[addr] = values[k];
+		}
+
+		if (line_state[i] != next_state)
+			continue;	// been here before
+
+		t_state_entry &state = states[next_state++];
+		si5351_freqs_reset(&state.freqs);
+		si5351_freqs_update(&state.freqs, regs, 1.0, SI5351_DEP_ALL);
+	}
+}
+
+int t_state_catalog::find(const uint64_t hash) const
+{
+	const std::vector < std::pair <uint64_t, uint32_t> >::const_iterator it = std::lower_bound(m_by_hash.begin(), m_by_hash.end(), std::make_pair(hash, (uint32_t)0));
+	return (it != m_by_hash.end() && it->first == hash) ? (int)it->second : -1;
+}
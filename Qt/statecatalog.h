@@ -0,0 +1,41 @@
+// Si5351 I2C data decoder
+//
+// Catalog of the distinct register configurations a capture goes through
+
+#ifndef STATECATALOG_H
+#define STATECATALOG_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+#include "si5351.h"
+#include "statehash.h"
+
+struct t_state_entry
+{
+	uint64_t       hash;
+	uint32_t       count;        // number of lines that leave the chip in this state
+	uint32_t       first_line;
+	uint32_t       last_line;
+	t_si5351_freqs freqs;        // relative to a 1Hz reference (scale by the XTAL frequency)
+};
+
+struct t_state_catalog
+{
+	std::vector <t_state_entry> states;      // in the order they're first reached
+	std::vector <uint32_t>      line_state;  // state of each line
+
+	void clear();
+
+	// the frequencies are only computed once for each distinct state
+	void build(const t_capture &capture, const t_state_hashes &hashes);
+
+	// -1 if the capture never reaches the state
+	int find(const uint64_t hash) const;
+
+private:
+	std::vector < std::pair <uint64_t, uint32_t> > m_by_hash;  // (hash, state) sorted by hash
+};
+
+#endif
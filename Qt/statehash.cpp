@@ -0,0 +1,143 @@
+// Si5351 I2C data decoder
+//
+// Zobrist hash of the 256 byte register image after each capture line
+//
+// every (address, value) pair has a fixed random 64-bit key, the hash of an image is the XOR
+// of the keys of its 256 bytes, so a write only XORs out the old key and XORs in the new one.
+// the keys are generated from a fixed seed, so hashes can be compared across captures
+
+#include <algorithm>
+
+#include "si5351.h"
+#include "statehash.h"
+
+// ****************************************************************
+
+static const uint64_t *si5351_zobrist_keys()
+{
+	static uint64_t keys[256 * 256];
+
+	// filled on first use .. C++11 makes the static init thread safe
+	struct t_init
+	{
+		t_init(uint64_t *k)
+		{	// splitmix64
+			uint64_t x = 0x5351c0ffee5351ull;
+			for (int i = 0; i < 256 * 256; i++)
+			{
+				uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				k[i] = z ^ (z >> 31);
+			}
+		}
+	};
+	static t_init init(keys);
+
+	return keys;
+}
+
+uint64_t si5351_state_hash(const uint8_t *reg_values)
+{
+	const uint64_t *keys = si5351_zobrist_keys();
+
+	uint64_t hash = 0;
+	for (int addr = 0; addr < 256; addr++)
+		hash ^= keys[(addr << 8) | reg_values[addr]];
+	return hash;
+}
+
+uint64_t si5351_state_hash_update(const uint64_t hash, const int addr, const uint8_t old_value, const uint8_t new_value)
+{
+	const uint64_t *keys = si5351_zobrist_keys();
+
+	return hash ^ keys[(addr << 8) | old_value] ^ keys[(addr << 8) | new_value];
+}
+
+// ****************************************************************
+
+void t_state_hashes::clear()
+{
+	line_hash.clear();
+	by_hash.clear();
+	distinct = 0;
+}
+
+void t_state_hashes::build(const t_capture &capture)
+{
+	clear();
+
+	uint8_t regs[256];
+	si5351_reset_regs(regs);
+
+	uint64_t hash = si5351_state_hash(regs);
+
+	line_hash.resize(capture.lines());
+
+	for (unsigned int i = 0; i < capture.lines(); i++)
+	{
+		const unsigned int size   = capture.lineDataSize(i);
+		const uint8_t     *values = capture.lineData(i);
+
+		if (size > 0)
+		{
+			// clear the PLL self clearing bits
+			const uint8_t reset = regs[SI5351_REG_PLL_RESET] & 0x5f;
+			hash = si5351_state_hash_update(hash, SI5351_REG_PLL_RESET, regs[SI5351_REG_PLL_RESET], reset);
+			regs[SI5351_REG_PLL_RESET] = reset;
+
+			int addr = values[0];
+			for (unsigned int k = 1; k < size && addr < 256; k++, addr++)
+			{
+				hash = si5351_state_hash_update(hash, addr, regs[addr], values[k]);
+				regs[addr] = values[k];
+			}
+		}
+
+		line_hash[i] = hash;
+	}
+
+	by_hash.resize(line_hash.size());
+	for (unsigned int i = 0; i < line_hash.size(); i++)
+		by_hash[i] = std::make_pair(line_hash[i], (uint32_t)i);
+	std::sort(by_hash.begin(), by_hash.end());
+
+	for (unsigned int i = 0; i < by_hash.size(); i++)
+		if (i == 0 || by_hash[i].first != by_hash[i - 1].first)
+			distinct++;
+}
+
+unsigned int t_state_hashes::count(const uint64_t hash) const
+{
+	const std::vector < std::pair <uint64_t, uint32_t> >::const_iterator lo = std::lower_bound(by_hash.begin(), by_hash.end(), std::make_pair(hash, (uint32_t)0));
+	const std::vector < std::pair <uint64_t, uint32_t> >::const_iterator hi = std::upper_bound(lo, by_hash.end(), std::make_pair(hash, (uint32_t)UINT32_MAX));
+	return (unsigned int)(hi - lo);
+}
+
+int t_state_hashes::next(const uint64_t hash, const int line) const
+{
+	const uint32_t from = (line < 0) ? 0 : (uint32_t)line + 1;
+
+	const std::vector < std::pair <uint64_t, uint32_t> >::const_iterator it = std::lower_bound(by_hash.begin(), by_hash.end(), std::make_pair(hash, from));
+	return (it != by_hash.end() && it->first == hash) ? (int)it->second : -1;
+}
+
+int t_state_hashes::prev(const uint64_t hash, const int line) const
+{
+	if (line <= 0)
+		return -1;
+
+	const std::vector < std::pair <uint64_t, uint32_t> >::const_iterator it = std::lower_bound(by_hash.begin(), by_hash.end(), std::make_pair(hash, (uint32_t)line));
+	if (it == by_hash.begin())
+		return -1;
+	return ((it - 1)->first == hash) ? (int)(it - 1)->second : -1;
+}
+
+void t_state_hashes::lines(const uint64_t hash, std::vector <uint32_t> &lines) const
+{
+	lines.clear();
+
+	std::vector < std::pair <uint64_t, uint32_t> >::const_iterator it = std::lower_bound(by_hash.begin(), by_hash.end(), std::make_pair(hash, (uint32_t)0));
+	for ( ; it != by_hash.end() && it->first == hash; ++it)
+		lines.push_back(it->second);
+}
@@ -0,0 +1,43 @@
+// Si5351 I2C data decoder
+//
+// Zobrist hash of the 256 byte register image after each capture line
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+
+// the hash of a whole register image
+uint64_t si5351_state_hash(const uint8_t *reg_values);
+
+// the hash after register 'addr' changes from 'old_value' to 'new_value' .. O(1)
+uint64_t si5351_state_hash_update(const uint64_t hash, const int addr, const uint8_t old_value, const uint8_t new_value);
+
+struct t_state_hashes
+{
+	std::vector <uint64_t> line_hash;      // register image hash after each line
+
+	// (hash, line) pairs sorted by hash then line, for the "same state" look ups
+	std::vector < std::pair <uint64_t, uint32_t> > by_hash;
+
+	unsigned int distinct;                 // number of distinct states
+
+	void clear();
+
+	void build(const t_capture &capture);
+
+	// number of lines that leave the chip in this state
+	unsigned int count(const uint64_t hash) const;
+
+	// the next/previous line after/before 'line' that leaves the chip in this state, -1 if none
+	int next(const uint64_t hash, const int line) const;
+	int prev(const uint64_t hash, const int line) const;
+
+	// every line that leaves the chip in this state
+	void lines(const uint64_t hash, std::vector <uint32_t> &lines) const;
+};
+
+#endif
@@ -0,0 +1,116 @@
+// Si5351 I2C data decoder
+//
+// Computes the register state of the selected capture line on a worker thread
+
+#include <QMutexLocker>
+
+#include <string.h>
+
+#include "stateworker.h"
+
+RegisterStateWorker::RegisterStateWorker(QObject *parent) :
+	QThread(parent),
+	m_capture(nullptr),
+	m_quit(false),
+	m_busy(false),
+	m_pending(false),
+	m_pending_line(-1),
+	m_have_result(false)
+{
+	memset(&m_result, 0, sizeof(m_result));
+}
+
+RegisterStateWorker::~RegisterStateWorker()
+{
+	{
+		QMutexLocker locker(&m_mutex);
+		m_quit = true;
+		m_request_cond.wakeAll();
+	}
+
+	wait();
+}
+
+void RegisterStateWorker::setCapture(const t_capture *capture)
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_pending = false;
+
+	while (m_busy)
+		m_idle_cond.wait(&m_mutex);
+
+	m_capture     = capture;
+	m_have_result = false;
+}
+
+void RegisterStateWorker::request(const int line)
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_pending      = true;
+	m_pending_line = line;
+
+	m_request_cond.wakeOne();
+}
+
+bool RegisterStateWorker::takeResult(t_register_state &state)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (!m_have_result)
+		return false;
+
+	memcpy(&state, &m_result, sizeof(state));
+	m_have_result = false;
+
+	return true;
+}
+
+void RegisterStateWorker::run()
+{
+	t_register_state state;
+
+	while (true)
+	{
+		const t_capture *capture;
+
+		{
+			QMutexLocker locker(&m_mutex);
+
+			while (!m_quit && (!m_pending || !m_capture))
+				m_request_cond.wait(&m_mutex);
+
+			if (m_quit)
+				break;
+
+			state.line = m_pending_line;
+			capture    = m_capture;
+			m_pending  = false;
+			m_busy     = true;
+		}
+
+		capture_replay(*capture, state.line, state.reg_values, state.updated_regs);
+
+		bool ready = false;
+
+		{
+			QMutexLocker locker(&m_mutex);
+
+			m_busy = false;
+
+			// don't bother publishing it if it's already been superseded
+			if (!m_pending && m_capture == capture)
+			{
+				memcpy(&m_result, &state, sizeof(m_result));
+				m_have_result = true;
+				ready         = true;
+			}
+
+			m_idle_cond.wakeAll();
+		}
+
+		if (ready)
+			emit stateReady();
+	}
+}
@@ -0,0 +1,61 @@
+// Si5351 I2C data decoder
+//
+// Computes the register state of the selected capture line on a worker thread
+
+#ifndef STATEWORKER_H
+#define STATEWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <stdint.h>
+
+#include "capture.h"
+
+struct t_register_state
+{
+	int     line;               // the line the state was computed for
+	uint8_t reg_values[256];
+	bool    updated_regs[256];  // registers written by that line
+};
+
+class RegisterStateWorker : public QThread
+{
+	Q_OBJECT
+
+public:
+	RegisterStateWorker(QObject *parent = nullptr);
+	~RegisterStateWorker();
+
+	// blocks until the worker has finished with the current capture, any pending request/result is dropped
+	void setCapture(const t_capture *capture);
+
+	// latest wins .. a request replaces any not yet started one
+	void request(const int line);
+
+	// the most recent result (if any)
+	bool takeResult(t_register_state &state);
+
+signals:
+	void stateReady();
+
+protected:
+	void run() override;
+
+private:
+	QMutex           m_mutex;
+	QWaitCondition   m_request_cond;
+	QWaitCondition   m_idle_cond;
+
+	const t_capture *m_capture;
+	bool             m_quit;
+	bool             m_busy;
+	bool             m_pending;
+	int              m_pending_line;
+
+	bool             m_have_result;
+	t_register_state m_result;
+};
+
+#endif
@@ -0,0 +1,355 @@
+// Si5351 I2C data decoder
+//
+// Batch frequency sweep planner .. one plan per frequency step, computed across threads, delivered in order
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <thread>
+#include <algorithm>
+
+#include "si5351.h"
+#include "sweep.h"
+#include "plancache.h"
+
+// ****************************************************************
+
+uint64_t sweep_points(const t_sweep_params &params)
+{
+	if (params.channels)
+		return params.channels->size();
+	if (params.step_Hz == 0 || params.stop_Hz < params.start_Hz)
+		return 0;
+	return 1 + ((uint64_t)(params.stop_Hz - params.start_Hz) / params.step_Hz);
+}
+
+uint32_t sweep_point_Hz(const t_sweep_params &params, const uint64_t i)
+{
+	if (params.channels)
+		return (*params.channels)[(size_t)i];
+	return (uint32_t)(params.start_Hz + (i * params.step_Hz));
+}
+
+static void sweep_plan_point_uncached(const t_sweep_params &params, const uint32_t freq_Hz, t_sweep_point &point)
+{
+	t_pll_plan plan;
+	pll_plan_init(plan, params.ref_Hz, params.frac_mode);
+	if (params.fixed_pll)
+	{
+		pll_plan_set_pll(plan, params.pll, params.fixed_pll_frac);
+		pll_plan_output_from_pll(plan, params.clk, params.pll, freq_Hz);
+	}
+	else
+	if (params.cost)
+	{
+		const t_pll_plan start = plan;
+		const t_plan_cost &cost = *params.cost;
+		const unsigned int plls = 1u << params.pll;
+		const unsigned int clks = 1u << params.clk;
+
+		pll_plan_output(plan, params.clk, params.pll, freq_Hz);
+		double best = (plan.clk_Hz[params.clk] > 0) ? cost.fn(plan, plls, clks, cost.context) : -1.0;
+
+		t_pll_plan candidate;
+		for (uint32_t a = 15; a <= 90; a++)
+		{
+			const uint64_t vco_Hz = (uint64_t)params.ref_Hz * a;
+			if (vco_Hz < SI5351_PLL_VCO_MIN_HZ || vco_Hz > SI5351_PLL_VCO_MAX_HZ)
+				continue;
+
+			const t_pll_frac frac = {a, 0, 1};
+			candidate = start;
+			pll_plan_set_pll(candidate, params.pll, frac);
+			if (pll_plan_output_from_pll(candidate, params.clk, params.pll, freq_Hz) == 0)
+				continue;
+
+			const double c = cost.fn(candidate, plls, clks, cost.context);
+			if (best < 0.0 || best > c)
+			{
+				best = c;
+				plan = candidate;
+			}
+		}
+	}
+	else
+	{
+		pll_plan_output(plan, params.clk, params.pll, freq_Hz);
+	}
+
+	const t_pll_plan_ms &ms = plan.ms[params.clk];
+
+	point.want_Hz  = freq_Hz;
+	point.clk_Hz   = plan.clk_Hz[params.clk];
+	point.err_uHz  = plan.clk_err_uHz[params.clk];
+	point.pll_Hz   = plan.pll_Hz[params.pll];
+	point.pll      = plan.pll[params.pll];
+	point.ms       = ms.div;
+	point.r_div    = ms.r_div;
+	point.div_by_4 = ms.div_by_4;
+
+	point.clk_ctrl = plan.regs[SI5351_REG_CLK0_CONTROL + params.clk];
+
+	memcpy(point.pll_regs, &plan.regs[SI5351_REG_PLLA_PARAMETERS + (8 * params.pll)], 8);
+
+	if (params.clk < 6)
+	{
+		memcpy(point.ms_regs, &plan.regs[SI5351_REG_MS0_PARAMETERS + (8 * params.clk)], 8);
+	}
+	else
+	{
+		memset(point.ms_regs, 0, sizeof(point.ms_regs));
+		point.ms_regs[0] = plan.regs[SI5351_REG_MS6_PARAMETERS + (params.clk - 6)];
+		point.ms_regs[1] = plan.regs[SI5351_REG_MS67_OUTPUT_DIVIDER];
+	}
+}
+
+void sweep_plan_point(const t_sweep_params &params, const uint32_t freq_Hz, t_sweep_point &point)
+{
+	if (!params.cache)
+	{
+		sweep_plan_point_uncached(params, freq_Hz, point);
+		return;
+	}
+
+	const t_plan_cache_key key = plan_cache_key(params, freq_Hz);
+	if (params.cache->find(key, point))
+		return;
+
+	sweep_plan_point_uncached(params, freq_Hz, point);
+	params.cache->insert(key, point);
+}
+
+static void sweep_plan_range(const t_sweep_params &params, const uint64_t first, const unsigned int count, t_sweep_point *points)
+{
+	for (unsigned int i = 0; i < count; i++)
+		sweep_plan_point(params, sweep_point_Hz(params, first + i), points[i]);
+}
+
+bool sweep_run(const t_sweep_params &params, const t_sweep_sink &sink)
+{
+	if (params.clk >= PLL_PLAN_OUTPUTS || params.pll >= 2 || params.ref_Hz == 0)
+		return false;
+
+	const uint64_t total = sweep_points(params);
+	if (total == 0)
+		return false;
+
+	unsigned int threads = params.threads;
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	// two rounds of buffers .. the threads compute the next round while this one is handed to the sink in order
+	const uint64_t round_points = (uint64_t)threads * SWEEP_CHUNK_POINTS;
+	std::vector <t_sweep_point> buffers[2];
+	buffers[0].resize((size_t)std::min <uint64_t> (round_points, total));
+	buffers[1].resize(buffers[0].size());
+
+	std::vector <std::thread> workers;
+
+	auto start_round = [&](const uint64_t first, std::vector <t_sweep_point> &buffer)
+	{
+		const unsigned int count = (unsigned int)std::min <uint64_t> (round_points, total - first);
+		for (unsigned int k = 0; k < threads; k++)
+		{
+			const unsigned int begin = k * SWEEP_CHUNK_POINTS;
+			if (begin >= count)
+				break;
+			const unsigned int n = std::min <unsigned int> (SWEEP_CHUNK_POINTS, count - begin);
+			workers.push_back(std::thread(sweep_plan_range, std::cref(params), first + begin, n, &buffer[begin]));
+		}
+		return count;
+	};
+
+	auto join_round = [&]()
+	{
+		for (unsigned int k = 0; k < workers.size(); k++)
+			workers[k].join();
+		workers.clear();
+	};
+
+	uint64_t     first = 0;
+	unsigned int count = start_round(first, buffers[0]);
+	join_round();
+
+	for (int b = 0; ; b ^= 1)
+	{
+		const uint64_t     next       = first + count;
+		const unsigned int next_count = (next < total) ? start_round(next, buffers[b ^ 1]) : 0;
+
+		const bool ok = sink(&buffers[b][0], count);
+
+		join_round();
+
+		if (!ok)
+			return false;
+
+		if (next_count == 0)
+			break;
+
+		first = next;
+		count = next_count;
+	}
+
+	return true;
+}
+
+// ****************************************************************
+
+unsigned int sweep_choose_fixed_pll(const t_sweep_params &params, const double err_budget_uHz, t_pll_frac &frac, unsigned int *samples)
+{
+	frac.a = 0;
+	frac.b = 0;
+	frac.c = 1;
+
+	const uint64_t total = sweep_points(params);
+	if (total == 0 || params.ref_Hz == 0 || params.clk >= PLL_PLAN_OUTPUTS || params.pll >= 2)
+		return 0;
+
+	// evenly spread sample of the range
+	const unsigned int n = (unsigned int)std::min <uint64_t> (total, SWEEP_FIXED_PLL_SAMPLES);
+	std::vector <uint32_t> freqs(n);
+	for (unsigned int i = 0; i < n; i++)
+	{
+		const uint64_t k = (n > 1) ? (i * (total - 1)) / (n - 1) : 0;
+		freqs[i] = sweep_point_Hz(params, k);
+	}
+	if (samples)
+		*samples = n;
+
+	// candidates .. the integer PLL frequencies first (highest first), then a grid across the VCO range
+	std::vector <uint32_t> vcos;
+	for (uint32_t vco = (SI5351_PLL_VCO_MAX_HZ / params.ref_Hz) * params.ref_Hz; vco >= SI5351_PLL_VCO_MIN_HZ; vco -= params.ref_Hz)
+		vcos.push_back(vco);
+	for (uint32_t vco = SI5351_PLL_VCO_MAX_HZ; vco >= SI5351_PLL_VCO_MIN_HZ; vco -= SWEEP_FIXED_PLL_GRID_HZ)
+		if ((vco % params.ref_Hz) != 0)
+			vcos.push_back(vco);
+
+	t_sweep_params p = params;
+	p.fixed_pll = true;
+	p.cache     = nullptr;	// the candidates' points would only push the useful ones out
+
+	unsigned int best = 0;
+
+	for (unsigned int v = 0; v < vcos.size(); v++)
+	{
+		pll_calc_pll(params.ref_Hz, vcos[v], &p.fixed_pll_frac.a, &p.fixed_pll_frac.b, &p.fixed_pll_frac.c, params.frac_mode);
+
+		unsigned int reached = 0;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			if (reached + (n - i) <= best)
+				break;	// can't beat the best so far
+
+			t_sweep_point point;
+			sweep_plan_point(p, freqs[i], point);
+			if (point.clk_Hz > 0 && fabs(point.err_uHz) <= err_budget_uHz)
+				reached++;
+		}
+
+		if (best < reached)
+		{	// strictly better only, so ties keep the earlier (integer PLL, higher VCO) candidate
+			best = reached;
+			frac = p.fixed_pll_frac;
+			if (best == n)
+				break;
+		}
+	}
+
+	return best;
+}
+
+// the register address of the i'th multisynth parameter byte of a sweep point
+static int sweep_ms_reg(const unsigned int clk, const unsigned int i)
+{
+	if (clk < 6)
+		return SI5351_REG_MS0_PARAMETERS + (8 * clk) + i;
+	if (i == 0)
+		return SI5351_REG_MS6_PARAMETERS + (clk - 6);
+	if (i == 1)
+		return SI5351_REG_MS67_OUTPUT_DIVIDER;
+	return -1;
+}
+
+void sweep_ms_delta(const t_sweep_params &params, const t_sweep_point &from, const t_sweep_point &to, const double scl_Hz, t_write_sequence &writes)
+{
+	uint8_t from_regs[256];
+	uint8_t to_regs[256];
+	bool    known[256];
+	memset(from_regs, 0, sizeof(from_regs));
+	memset(to_regs, 0, sizeof(to_regs));
+	memset(known, 0, sizeof(known));
+
+	from_regs[SI5351_REG_CLK0_CONTROL + params.clk] = from.clk_ctrl;
+	to_regs[SI5351_REG_CLK0_CONTROL + params.clk]   = to.clk_ctrl;
+	known[SI5351_REG_CLK0_CONTROL + params.clk]     = true;
+
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		const int reg = sweep_ms_reg(params.clk, i);
+		if (reg < 0)
+			break;
+		from_regs[reg] = from.ms_regs[i];
+		to_regs[reg]   = to.ms_regs[i];
+		known[reg]     = true;
+	}
+
+	writes.build(from_regs, to_regs, scl_Hz, known);
+}
+
+// ****************************************************************
+
+void sweep_csv_header(std::string &s)
+{
+	s = "want_Hz,clk_Hz,err_uHz,pll_Hz,pll_a,pll_b,pll_c,ms_a,ms_b,ms_c,r_div,div_by_4,pll_regs,ms_regs\n";
+}
+
+void sweep_csv_line(const t_sweep_point &point, std::string &s)
+{
+	char buf[256];
+	int n = snprintf(buf, sizeof(buf), "%u,%u,%0.3f,%u,%u,%u,%u,%u,%u,%u,%u,%u,",
+		point.want_Hz,
+		point.clk_Hz,
+		point.err_uHz,
+		point.pll_Hz,
+		point.pll.a, point.pll.b, point.pll.c,
+		point.ms.a, point.ms.b, point.ms.c,
+		point.r_div,
+		point.div_by_4);
+
+	for (int i = 0; i < 8; i++)
+		n += snprintf(buf + n, sizeof(buf) - n, "%02X", point.pll_regs[i]);
+	buf[n++] = ',';
+	for (int i = 0; i < 8; i++)
+		n += snprintf(buf + n, sizeof(buf) - n, "%02X", point.ms_regs[i]);
+	buf[n++] = '\n';
+
+	s.append(buf, n);
+}
+
+static uint8_t *sweep_put_u32(uint8_t *p, const uint32_t v)
+{
+	*p++ = (v >>  0) & 0xff;
+	*p++ = (v >>  8) & 0xff;
+	*p++ = (v >> 16) & 0xff;
+	*p++ = (v >> 24) & 0xff;
+	return p;
+}
+
+void sweep_binary_record(const t_sweep_point &point, uint8_t *record)
+{
+	uint8_t *p = record;
+
+	p = sweep_put_u32(p, point.want_Hz);
+	p = sweep_put_u32(p, point.clk_Hz);
+
+	uint64_t err;
+	memcpy(&err, &point.err_uHz, sizeof(err));
+	p = sweep_put_u32(p, (uint32_t)(err >>  0));
+	p = sweep_put_u32(p, (uint32_t)(err >> 32));
+
+	memcpy(p, point.pll_regs, 8);
+	p += 8;
+	memcpy(p, point.ms_regs, 8);
+}
@@ -0,0 +1,93 @@
+// Si5351 I2C data decoder
+//
+// Batch frequency sweep planner .. one plan per frequency step (or channel table entry), computed across threads, delivered in order
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+#include "pllplan.h"
+#include "writeseq.h"
+#include "plancost.h"
+
+class t_plan_cache;
+
+#define SWEEP_CHUNK_POINTS      8192    // points per thread per round
+
+// binary record .. all little endian
+//   uint32 want_Hz, uint32 clk_Hz, double err_uHz, uint8 pll_regs[8], uint8 ms_regs[8]
+#define SWEEP_RECORD_SIZE       (4 + 4 + 8 + 8 + 8)
+
+struct t_sweep_params
+{
+	uint32_t     ref_Hz;
+	uint32_t     start_Hz;
+	uint32_t     stop_Hz;       // inclusive
+	uint32_t     step_Hz;
+	const std::vector <uint32_t> *channels;    // a channel table instead of start/stop/step (nullptr = the range)
+	unsigned int clk;           // output 0 to 7
+	unsigned int pll;           // 0 = PLL-A, 1 = PLL-B
+	int          frac_mode;     // PLL_FRAC_xxx
+	unsigned int threads;       // 0 = one per core
+
+	bool       fixed_pll;       // keep the PLL at 'fixed_pll_frac', only the multisynth changes from step to step
+	t_pll_frac fixed_pll_frac;
+
+	const t_plan_cost *cost;    // rank each point's candidate plans by this (nullptr = the planner's own choice)
+
+	t_plan_cache *cache;        // planned points are looked up here first and added after (nullptr = no cache)
+};
+
+// fixed PLL VCO search
+#define SWEEP_FIXED_PLL_SAMPLES     2048        // points of the range the VCO candidates are scored on
+#define SWEEP_FIXED_PLL_GRID_HZ     1000000     // fractional VCO candidates every ..
+
+struct t_sweep_point
+{
+	uint32_t   want_Hz;
+	uint32_t   clk_Hz;          // achieved
+	double     err_uHz;
+	uint32_t   pll_Hz;
+	t_pll_frac pll;
+	t_pll_frac ms;
+	uint8_t    r_div;
+	uint8_t    div_by_4;
+	uint8_t    pll_regs[8];     // the PLL parameter registers
+	uint8_t    ms_regs[8];      // the multisynth parameter registers (MS6/7 .. P1 and the shared R-divider register)
+	uint8_t    clk_ctrl;        // the CLK control register (multisynth integer mode bit)
+};
+
+// called with the points in frequency order, return false to stop the sweep
+typedef std::function <bool (const t_sweep_point *points, const unsigned int count)> t_sweep_sink;
+
+// number of points in the sweep
+uint64_t sweep_points(const t_sweep_params &params);
+
+// the frequency of the i'th point
+uint32_t sweep_point_Hz(const t_sweep_params &params, const uint64_t i);
+
+// plan a single point .. with a cost function the planner's own choice and the integer PLL VCO frequencies (fractional
+// multisynth) are tried, the lowest cost wins, the planner's choice on a tie
+void sweep_plan_point(const t_sweep_params &params, const uint32_t freq_Hz, t_sweep_point &point);
+
+// run the sweep, returns false if the sink stopped it or the parameters are no good
+bool sweep_run(const t_sweep_params &params, const t_sweep_sink &sink);
+
+// pick the one PLL VCO frequency that reaches the most points of the sweep range within the error budget by multisynth
+// changes alone (scored on a sample of the range) .. integer PLL frequencies win ties, then the highest VCO,
+// returns the number of sampled points reached and how many were sampled
+unsigned int sweep_choose_fixed_pll(const t_sweep_params &params, const double err_budget_uHz, t_pll_frac &frac, unsigned int *samples = nullptr);
+
+// the register writes that move the output from one fixed PLL point to the next .. only multisynth/CLK control registers
+void sweep_ms_delta(const t_sweep_params &params, const t_sweep_point &from, const t_sweep_point &to, const double scl_Hz, t_write_sequence &writes);
+
+// output formats
+void sweep_csv_header(std::string &s);
+void sweep_csv_line(const t_sweep_point &point, std::string &s);     // appends
+void sweep_binary_record(const t_sweep_point &point, uint8_t *record);
+
+#endif
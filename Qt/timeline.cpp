@@ -0,0 +1,164 @@
+// Si5351 I2C data decoder
+//
+// Per-line PLL/CLK frequency timeline of a capture, with min/max level-of-detail pyramids for plotting
+
+#include <algorithm>
+#include <limits>
+
+#include <string.h>
+
+#include "si5351.h"
+#include "timeline.h"
+
+// ****************************************************************
+
+void t_freq_series::clear()
+{
+	line.clear();
+	value.clear();
+	lod_min.clear();
+	lod_max.clear();
+}
+
+void t_freq_series::buildLOD()
+{
+	const float inf = std::numeric_limits<float>::infinity();
+
+	lod_min.clear();
+	lod_max.clear();
+
+	if (value.empty())
+		return;
+
+	// level 0
+	lod_min.push_back(std::vector <float> (value.size()));
+	lod_max.push_back(std::vector <float> (value.size()));
+	for (unsigned int i = 0; i < value.size(); i++)
+	{
+		lod_min[0][i] = (value[i] > 0.0) ? (float)value[i] : inf;
+		lod_max[0][i] = (float)value[i];
+	}
+
+	// each level halves the one below it
+	while (lod_min.back().size() > 1)
+	{
+		const std::vector <float> &src_min = lod_min.back();
+		const std::vector <float> &src_max = lod_max.back();
+		const unsigned int         n       = (unsigned int)(src_min.size() + 1) / 2;
+
+		std::vector <float> dst_min(n);
+		std::vector <float> dst_max(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			const unsigned int k = i * 2;
+			dst_min[i] = (k + 1 < src_min.size()) ? std::min(src_min[k], src_min[k + 1]) : src_min[k];
+			dst_max[i] = (k + 1 < src_max.size()) ? std::max(src_max[k], src_max[k + 1]) : src_max[k];
+		}
+
+		lod_min.push_back(dst_min);
+		lod_max.push_back(dst_max);
+	}
+}
+
+int t_freq_series::indexAt(const uint32_t at_line) const
+{
+	return (int)(std::upper_bound(line.begin(), line.end(), at_line) - line.begin()) - 1;
+}
+
+bool t_freq_series::rangeMinMax(unsigned int i0, unsigned int i1, float &min_value, float &max_value) const
+{
+	const float inf = std::numeric_limits<float>::infinity();
+
+	float mn = inf;
+	float mx = 0.0f;
+
+	if (i1 > value.size())
+		i1 = (unsigned int)value.size();
+
+	// walk up the pyramid taking the largest aligned blocks that fit .. O(log n)
+	unsigned int level = 0;
+	while (i0 < i1 && level < lod_min.size())
+	{
+		if (i0 & 1)
+		{
+			mn = std::min(mn, lod_min[level][i0]);
+			mx = std::max(mx, lod_max[level][i0]);
+			i0++;
+		}
+		if (i1 & 1)
+		{
+			i1--;
+			mn = std::min(mn, lod_min[level][i1]);
+			mx = std::max(mx, lod_max[level][i1]);
+		}
+		i0 >>= 1;
+		i1 >>= 1;
+		level++;
+	}
+
+	if (mn == inf)
+		return false;
+
+	min_value = mn;
+	max_value = mx;
+	return true;
+}
+
+// ****************************************************************
+
+void t_freq_timeline::clear()
+{
+	lines = 0;
+	for (int i = 0; i < TIMELINE_SERIES_COUNT; i++)
+		series[i].clear();
+	line_time.clear();
+}
+
+void t_freq_timeline::build(const t_capture &capture, const t_state_catalog &catalog)
+{
+	clear();
+
+	lines = capture.lines();
+	if (catalog.line_state.size() != lines)
+		return;
+
+	// the frequencies were computed once per distinct state by the catalog
+	for (unsigned int i = 0; i < lines; i++)
+	{
+		if (i > 0 && catalog.line_state[i] == catalog.line_state[i - 1])
+			continue;
+
+		const t_si5351_freqs &freqs = catalog.states[catalog.line_state[i]].freqs;
+
+		const double Hz[TIMELINE_SERIES_COUNT] = {freqs.pll_Hz[0], freqs.pll_Hz[1], freqs.clk_Hz[0], freqs.clk_Hz[1], freqs.clk_Hz[2]};
+		for (int s = 0; s < TIMELINE_SERIES_COUNT; s++)
+		{
+			t_freq_series &ser = series[s];
+			if (ser.value.empty() || ser.value.back() != Hz[s])
+			{
+				ser.line.push_back(i);
+				ser.value.push_back(Hz[s]);
+			}
+		}
+	}
+
+	for (int s = 0; s < TIMELINE_SERIES_COUNT; s++)
+		series[s].buildLOD();
+
+	if (capture.hasTimes())
+	{	// lines without a time stamp take the previous one
+		line_time.resize(capture.lines());
+		double t = 0.0;
+		for (unsigned int i = 0; i < capture.lines(); i++)
+		{
+			if (capture.line_time[i] >= t)
+				t = capture.line_time[i];
+			line_time[i] = t;
+		}
+	}
+}
+
+unsigned int t_freq_timeline::lineAtTime(const double seconds) const
+{
+	return (unsigned int)(std::lower_bound(line_time.begin(), line_time.end(), seconds) - line_time.begin());
+}
@@ -0,0 +1,62 @@
+// Si5351 I2C data decoder
+//
+// Per-line PLL/CLK frequency timeline of a capture, with min/max level-of-detail pyramids for plotting
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "capture.h"
+#include "statecatalog.h"
+
+#define TIMELINE_SERIES_PLLA        0
+#define TIMELINE_SERIES_PLLB        1
+#define TIMELINE_SERIES_CLK0        2
+#define TIMELINE_SERIES_CLK1        3
+#define TIMELINE_SERIES_CLK2        4
+#define TIMELINE_SERIES_COUNT       5
+
+// a step function .. the value only changes at the stored lines
+//
+// the values are relative to the reference frequency (1Hz ref), every frequency
+// scales linearly with it so a new XTAL frequency doesn't need a rebuild
+struct t_freq_series
+{
+	std::vector <uint32_t> line;     // line at which the value changed
+	std::vector <double>   value;    // the new value (0 = no output)
+
+	// level k holds the min (ignoring 0's) and max of each aligned block of 2^k points
+	std::vector < std::vector <float> > lod_min;
+	std::vector < std::vector <float> > lod_max;
+
+	void clear();
+
+	void buildLOD();
+
+	// index of the point in effect at 'line', -1 if before the first point
+	int indexAt(const uint32_t at_line) const;
+
+	// min/max of points [i0, i1), false if they are all 0
+	bool rangeMinMax(unsigned int i0, unsigned int i1, float &min_value, float &max_value) const;
+};
+
+struct t_freq_timeline
+{
+	unsigned int  lines;
+	t_freq_series series[TIMELINE_SERIES_COUNT];
+
+	// time of each line, only if the capture is time stamped (lines without a stamp take the previous one)
+	std::vector <double> line_time;
+
+	void clear();
+
+	// the frequencies after each line, taken from the catalog state each line leaves the chip in
+	void build(const t_capture &capture, const t_state_catalog &catalog);
+
+	// first line whose time is >= 'seconds'
+	unsigned int lineAtTime(const double seconds) const;
+};
+
+#endif
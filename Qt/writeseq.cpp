@@ -0,0 +1,137 @@
+// Si5351 I2C data decoder
+//
+// Minimal I2C write sequence that takes the chip from one register image to another
+
+#include <stdio.h>
+
+#include "si5351.h"
+#include "i2cbus.h"
+#include "writeseq.h"
+
+// ****************************************************************
+
+// registers a burst can carry on through by rewriting the current value
+static bool writeseq_bridgeable(const int addr)
+{
+	if (addr == SI5351_REG_DEVICE_STATUS || addr == SI5351_REG_INTERRUPT_STATUS_STICKY)
+		return false;
+
+	for (unsigned int i = 0; i < si5351_reg_list_count; i++)
+		if (si5351_reg_list[i].addr == addr)
+			return true;
+
+	return false;	// reserved
+}
+
+void t_write_sequence::clear()
+{
+	bursts.clear();
+	changed   = 0;
+	bridged   = 0;
+	pll_reset = 0;
+	scl_Hz    = 0.0;
+}
+
+void t_write_sequence::build(const uint8_t *current, const uint8_t *target, const double scl_Hz, const bool *known)
+{
+	clear();
+
+	this->scl_Hz = scl_Hz;
+
+	uint8_t regs[256];
+	for (int addr = 0; addr < 256; addr++)
+		regs[addr] = current[addr];
+	regs[SI5351_REG_PLL_RESET] &= 0x5f;
+
+	// the target image never has the self clearing reset bits set (capture_replay() clears them), so a PLL whose
+	// parameters change gets its reset written after everything else
+	for (int i = 0; i < 8; i++)
+	{
+		if (regs[SI5351_REG_PLLA_PARAMETERS + i] != target[SI5351_REG_PLLA_PARAMETERS + i])
+			pll_reset |= 0x20;
+		if (regs[SI5351_REG_PLLB_PARAMETERS + i] != target[SI5351_REG_PLLB_PARAMETERS + i])
+			pll_reset |= 0x80;
+	}
+
+	// every gap between two changed registers costs the same whichever way the other gaps go, so deciding each one on
+	// its own (bridge it if rewriting the unchanged bytes is quicker than a new transaction) gives the shortest sequence
+	const double byte_secs  = (scl_Hz > 0.0) ? I2C_BITS_PER_BYTE / scl_Hz : 0.0;
+	const double split_secs = i2c_transaction_overhead_secs(scl_Hz);
+
+	int last = -1;	// last changed register written
+
+	for (int addr = 0; addr < 256; addr++)
+	{
+		if (regs[addr] == target[addr] || addr == SI5351_REG_DEVICE_STATUS || addr == SI5351_REG_INTERRUPT_STATUS_STICKY)
+			continue;
+		if (addr == SI5351_REG_PLL_RESET && pll_reset)
+			continue;	// written with the reset
+
+		changed++;
+
+		bool bridge = false;
+		if (last >= 0)
+		{
+			const int gap = addr - last - 1;
+			bridge = (gap * byte_secs < split_secs);
+			for (int a = last + 1; a < addr && bridge; a++)
+				bridge = writeseq_bridgeable(a) && (!known || known[a]);
+		}
+
+		if (bridge)
+		{
+			t_i2c_burst &burst = bursts.back();
+			for (int a = last + 1; a < addr; a++)
+			{
+				burst.values.push_back(regs[a]);
+				bridged++;
+			}
+		}
+		else
+		{
+			bursts.push_back(t_i2c_burst());
+			bursts.back().addr = (uint8_t)addr;
+		}
+
+		bursts.back().values.push_back(target[addr]);
+		last = addr;
+	}
+
+	if (pll_reset)
+	{
+		changed++;
+		bursts.push_back(t_i2c_burst());
+		bursts.back().addr = SI5351_REG_PLL_RESET;
+		bursts.back().values.push_back((target[SI5351_REG_PLL_RESET] & 0x5f) | pll_reset);
+	}
+}
+
+double t_write_sequence::busSecs() const
+{
+	double secs = 0.0;
+	for (unsigned int i = 0; i < bursts.size(); i++)
+		secs += i2c_write_secs(1 + (unsigned int)bursts[i].values.size(), scl_Hz);
+	if (bursts.size() > 1)
+		secs += (bursts.size() - 1) * i2c_bus_free_secs(scl_Hz);
+	return secs;
+}
+
+void t_write_sequence::text(std::string &s) const
+{
+	s.clear();
+
+	char buf[8];
+	for (unsigned int i = 0; i < bursts.size(); i++)
+	{
+		const t_i2c_burst &burst = bursts[i];
+
+		snprintf(buf, sizeof(buf), "0x%02X", burst.addr);
+		s += buf;
+		for (unsigned int k = 0; k < burst.values.size(); k++)
+		{
+			snprintf(buf, sizeof(buf), " 0x%02X", burst.values[k]);
+			s += buf;
+		}
+		s += "\n";
+	}
+}
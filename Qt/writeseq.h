@@ -0,0 +1,42 @@
+// Si5351 I2C data decoder
+//
+// Minimal I2C write sequence that takes the chip from one register image to another
+
+#ifndef WRITESEQ_H
+#define WRITESEQ_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct t_i2c_burst
+{
+	uint8_t               addr;     // register start address
+	std::vector <uint8_t> values;
+};
+
+struct t_write_sequence
+{
+	std::vector <t_i2c_burst> bursts;   // in register address order
+
+	unsigned int changed;   // registers that differ
+	unsigned int bridged;   // unchanged registers rewritten to save starting another burst
+	uint8_t      pll_reset; // reset bits of the final PLL reset burst (0x20 PLL-A, 0x80 PLL-B), 0 if no PLL changed
+
+	double scl_Hz;
+
+	void clear();
+
+	// the PLL reset bits of 'current' are taken as already cleared, read only registers are never written, a PLL
+	// whose parameters change is reset by a final burst (counted as a changed register),
+	// if 'known' is given only the registers flagged in it can be bridged (the others' values aren't known)
+	void build(const uint8_t *current, const uint8_t *target, const double scl_Hz, const bool *known = nullptr);
+
+	// estimated bus time of the whole sequence (including the bus free time between the bursts)
+	double busSecs() const;
+
+	// one "0xAA 0xDD .." line per burst, the same format the capture files are in
+	void text(std::string &s) const;
+};
+
+#endif
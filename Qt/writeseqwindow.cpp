@@ -0,0 +1,155 @@
+// Si5351 I2C data decoder
+//
+// Write sequence window .. the minimal I2C writes that take the chip from one line's register state to another's
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QFile>
+#include <QDir>
+#include <QMessageBox>
+
+#include "si5351.h"
+#include "writeseqwindow.h"
+
+// ****************************************************************
+
+WriteSequenceWindow::WriteSequenceWindow(QWidget *parent) :
+	QWidget(parent, Qt::Window),
+	m_capture(nullptr)
+{
+	setWindowTitle("Write sequence");
+
+	m_from_spin = new QSpinBox(this);
+	m_from_spin->setRange(0, 0);
+	m_from_spin->setSpecialValueText("reset");
+
+	m_to_spin = new QSpinBox(this);
+	m_to_spin->setRange(0, 0);
+	m_to_spin->setSpecialValueText("reset");
+
+	m_scl_combo = new QComboBox(this);
+	m_scl_combo->addItem("100 kHz", 100000.0);
+	m_scl_combo->addItem("400 kHz", 400000.0);
+	m_scl_combo->addItem("1 MHz", 1000000.0);
+	m_scl_combo->setCurrentIndex(1);
+
+	m_save_button = new QPushButton("Save ..", this);
+
+	m_summary_label = new QLabel(this);
+
+	m_text_edit = new QPlainTextEdit(this);
+	m_text_edit->setReadOnly(true);
+	m_text_edit->setLineWrapMode(QPlainTextEdit::NoWrap);
+
+	QHBoxLayout *top = new QHBoxLayout();
+	top->addWidget(new QLabel("From line", this));
+	top->addWidget(m_from_spin);
+	top->addWidget(new QLabel("to line", this));
+	top->addWidget(m_to_spin);
+	top->addWidget(new QLabel("SCL", this));
+	top->addWidget(m_scl_combo);
+	top->addStretch(1);
+	top->addWidget(m_save_button);
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addLayout(top);
+	layout->addWidget(m_summary_label);
+	layout->addWidget(m_text_edit, 1);
+
+	connect(m_from_spin, SIGNAL(valueChanged(int)), this, SLOT(onChanged()));
+	connect(m_to_spin, SIGNAL(valueChanged(int)), this, SLOT(onChanged()));
+	connect(m_scl_combo, SIGNAL(currentIndexChanged(int)), this, SLOT(onChanged()));
+	connect(m_save_button, SIGNAL(clicked()), this, SLOT(onSave()));
+
+	resize(700, 400);
+}
+
+void WriteSequenceWindow::setCapture(const t_capture *capture)
+{
+	m_capture = capture;
+
+	const int lines = capture ? (int)capture->lines() : 0;
+
+	m_from_spin->setRange(0, lines);
+	m_to_spin->setRange(0, lines);
+
+	onChanged();
+}
+
+void WriteSequenceWindow::setToLine(const int line)
+{
+	if (line >= 0)
+		m_to_spin->setValue(1 + line);
+}
+
+void WriteSequenceWindow::onChanged()
+{
+	m_sequence.clear();
+
+	if (!m_capture)
+	{
+		m_summary_label->setText("");
+		m_text_edit->setPlainText("");
+		return;
+	}
+
+	// the register images after the two lines
+	uint8_t from_regs[256];
+	uint8_t to_regs[256];
+	bool    updated_regs[256];
+
+	if (m_from_spin->value() > 0)
+		capture_replay(*m_capture, m_from_spin->value() - 1, from_regs, updated_regs);
+	else
+		si5351_reset_regs(from_regs);
+
+	if (m_to_spin->value() > 0)
+		capture_replay(*m_capture, m_to_spin->value() - 1, to_regs, updated_regs);
+	else
+		si5351_reset_regs(to_regs);
+
+	const double scl_Hz = m_scl_combo->currentData().toDouble();
+
+	m_sequence.build(from_regs, to_regs, scl_Hz);
+
+	std::string text;
+	m_sequence.text(text);
+
+	QString s;
+	s.sprintf("%u registers differ, %u unchanged registers bridged, %u bursts, %0.1f us at %s",
+		m_sequence.changed,
+		m_sequence.bridged,
+		(unsigned int)m_sequence.bursts.size(),
+		m_sequence.busSecs() * 1e6,
+		m_scl_combo->currentText().toLatin1().constData());
+
+	if (m_sequence.pll_reset)
+	{
+		const bool a = (m_sequence.pll_reset & 0x20) != 0;
+		const bool b = (m_sequence.pll_reset & 0x80) != 0;
+		s += QString(", ends with a ") + ((a && b) ? "PLL-A and PLL-B" : a ? "PLL-A" : "PLL-B") + " reset";
+	}
+
+	m_summary_label->setText(s);
+	m_text_edit->setPlainText(QString::fromStdString(text));
+}
+
+void WriteSequenceWindow::onSave()
+{
+	QString filename = QFileDialog::getSaveFileName(this, tr("Save I2C write sequence"), QDir::currentPath(), tr("I2C capture (*.txt);;All Files (*)"));
+	if (filename.isEmpty())
+		return;
+
+	QFile file(filename);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		QMessageBox::critical(this, windowTitle(), "Unable to create " + filename);
+		return;
+	}
+
+	std::string text;
+	m_sequence.text(text);
+	file.write(text.c_str(), (qint64)text.size());
+	file.close();
+}
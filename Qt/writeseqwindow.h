@@ -0,0 +1,49 @@
+// Si5351 I2C data decoder
+//
+// Write sequence window .. the minimal I2C writes that take the chip from one line's register state to another's
+
+#ifndef WRITESEQWINDOW_H
+#define WRITESEQWINDOW_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QPushButton>
+#include <QPlainTextEdit>
+
+#include "capture.h"
+#include "writeseq.h"
+
+class WriteSequenceWindow : public QWidget
+{
+	Q_OBJECT
+
+public:
+	WriteSequenceWindow(QWidget *parent = nullptr);
+
+	// the capture must stay alive (and unchanged) until the next setCapture() call
+	void setCapture(const t_capture *capture);
+
+	// the target line (0 based)
+	void setToLine(const int line);
+
+private slots:
+	void onChanged();
+
+	void onSave();
+
+private:
+	const t_capture *m_capture;
+
+	t_write_sequence m_sequence;
+
+	QSpinBox       *m_from_spin;    // 0 = the reset state, otherwise 1 based line
+	QSpinBox       *m_to_spin;      //   "
+	QComboBox      *m_scl_combo;
+	QPushButton    *m_save_button;
+	QLabel         *m_summary_label;
+	QPlainTextEdit *m_text_edit;
+};
+
+#endif